@@ -0,0 +1,52 @@
+#include "RAllocator.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void *rallocator_malloc_alloc(void *context, size_t size)
+{
+    (void)context;
+    return (malloc(size));
+}
+
+static void *rallocator_malloc_realloc(void *context, void *ptr, size_t old_size, size_t new_size)
+{
+    (void)context;
+    (void)old_size;
+    return (realloc(ptr, new_size));
+}
+
+static void rallocator_malloc_free(void *context, void *ptr, size_t size)
+{
+    (void)context;
+    (void)size;
+    free(ptr);
+}
+
+static const RAllocator rallocator_malloc = {
+    rallocator_malloc_alloc,
+    rallocator_malloc_realloc,
+    rallocator_malloc_free,
+    NULL
+};
+
+const RAllocator *rallocator_default(void)
+{
+    return (&rallocator_malloc);
+}
+
+void *rallocator_realloc(const RAllocator *allocator, void *ptr, size_t old_size, size_t new_size)
+{
+    if (allocator->realloc != NULL)
+        return (allocator->realloc(allocator->context, ptr, old_size, new_size));
+
+    void *block = allocator->alloc(allocator->context, new_size);
+    if (block == NULL)
+        return (NULL);
+    if (ptr != NULL)
+    {
+        memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+        allocator->free(allocator->context, ptr, old_size);
+    }
+    return (block);
+}
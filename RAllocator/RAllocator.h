@@ -0,0 +1,93 @@
+/**
+ * @file RAllocator.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RALLOCATOR_H__
+#define __RALLOCATOR_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Memory allocator used by the containers.
+ *
+ * Every container can be constructed with an allocator. The callbacks receive
+ * the context pointer as their first argument and the size of the block on
+ * reallocation and release, so arena and pool allocators do not have to keep
+ * their own bookkeeping. The container copies the structure, so it does not
+ * need to outlive the call to the init function (the context does).
+ */
+typedef struct RAllocator
+{
+    void *(*alloc)(void *context, size_t size);
+    void *(*realloc)(void *context, void *ptr, size_t old_size, size_t new_size);
+    void (*free)(void *context, void *ptr, size_t size);
+    void *context;
+} RAllocator;
+
+/**
+ * @brief Get the allocator backed by malloc, realloc and free.
+ *
+ * Containers created without an allocator use this one.
+ *
+ * @return A pointer to the default allocator.
+ */
+const RAllocator *rallocator_default(void);
+
+/**
+ * @brief Check whether two allocators manage the same memory.
+ *
+ * Memory obtained from one allocator may only be released through another
+ * if both use the same callbacks and context.
+ *
+ * @param a The first allocator.
+ * @param b The second allocator.
+ * @return true if memory from a can be released through b, otherwise false.
+ */
+static inline bool rallocator_equal(const RAllocator *a, const RAllocator *b)
+{
+    return (a->alloc == b->alloc && a->free == b->free && a->context == b->context);
+}
+
+/**
+ * @brief Allocate memory through an allocator.
+ *
+ * @param allocator The allocator to use.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL on failure.
+ */
+static inline void *rallocator_alloc(const RAllocator *allocator, size_t size)
+{
+    return (allocator->alloc(allocator->context, size));
+}
+
+/**
+ * @brief Resize memory obtained from an allocator.
+ *
+ * If the allocator has no realloc callback, a new block is allocated, the
+ * contents are copied and the old block is released.
+ *
+ * @param allocator The allocator to use.
+ * @param ptr The block to resize, or NULL.
+ * @param old_size The current size of the block in bytes.
+ * @param new_size The requested size in bytes.
+ * @return A pointer to the resized memory, or NULL on failure (ptr stays valid).
+ */
+void *rallocator_realloc(const RAllocator *allocator, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Release memory obtained from an allocator.
+ *
+ * @param allocator The allocator to use.
+ * @param ptr The block to release, or NULL.
+ * @param size The size of the block in bytes.
+ */
+static inline void rallocator_free(const RAllocator *allocator, void *ptr, size_t size)
+{
+    if (ptr != NULL)
+        allocator->free(allocator->context, ptr, size);
+}
+
+#endif //__RALLOCATOR_H__
@@ -0,0 +1,102 @@
+#include "RArrayStack.h"
+#include "RCopy.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct RArrayStack
+{
+    unsigned char *data;
+    size_t capacity;
+    size_t size;
+    size_t type_size;
+    RAllocator allocator;
+} RArrayStack;
+
+static bool rastack_grow(RArrayStack *stack)
+{
+    size_t capacity = stack->capacity * 2;
+    void *temp = rallocator_realloc(&stack->allocator, stack->data,
+        stack->capacity * stack->type_size, capacity * stack->type_size);
+    if (temp == NULL)
+        return (false);
+    stack->data = (unsigned char *)temp;
+    stack->capacity = capacity;
+    return (true);
+}
+
+RArrayStack *rastack_init(size_t type_size)
+{
+    return (rastack_init_alloc(type_size, NULL));
+}
+
+RArrayStack *rastack_init_alloc(size_t type_size, const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RArrayStack *stack = (RArrayStack *)rallocator_alloc(allocator, sizeof(RArrayStack));
+    if (stack == NULL)
+        return (NULL);
+    stack->allocator = *allocator;
+    stack->capacity = RASTACK_INITIAL_CAPACITY;
+    stack->size = 0;
+    stack->type_size = type_size;
+    stack->data = (unsigned char *)rallocator_alloc(allocator, stack->capacity * type_size);
+    if (stack->data == NULL)
+    {
+        rallocator_free(allocator, stack, sizeof(RArrayStack));
+        return (NULL);
+    }
+    return (stack);
+}
+
+void rastack_destroy(RArrayStack *stack)
+{
+    RAllocator allocator = stack->allocator;
+    rallocator_free(&allocator, stack->data, stack->capacity * stack->type_size);
+    rallocator_free(&allocator, stack, sizeof(RArrayStack));
+}
+
+bool rastack_push(RArrayStack *stack, const void *data)
+{
+    if (stack->size == stack->capacity && !rastack_grow(stack))
+        return (false);
+    rcopy_element(stack->data + stack->size * stack->type_size, data, stack->type_size);
+    stack->size++;
+    return (true);
+}
+
+bool rastack_pop(RArrayStack *stack, void *out)
+{
+    if (stack->size == 0)
+        return (false);
+    stack->size--;
+    if (out != NULL)
+        rcopy_element(out, stack->data + stack->size * stack->type_size, stack->type_size);
+    return (true);
+}
+
+void *rastack_top(const RArrayStack *stack)
+{
+    if (stack->size == 0)
+        return (NULL);
+    return (stack->data + (stack->size - 1) * stack->type_size);
+}
+
+size_t rastack_get_size(const RArrayStack *stack)
+{
+    return (stack->size);
+}
+
+bool rastack_is_empty(const RArrayStack *stack)
+{
+    return (stack->size == 0);
+}
+
+void rastack_print(const RArrayStack *stack, void (*print)(void *))
+{
+    for (size_t i = stack->size; i > 0; i--)
+        print(stack->data + (i - 1) * stack->type_size);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file RArrayStack.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RARRAYSTACK_H__
+#define __RARRAYSTACK_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+/** Number of elements an array stack has room for before it first grows. */
+#define RASTACK_INITIAL_CAPACITY 16
+
+struct RArrayStack;
+typedef struct RArrayStack RArrayStack;
+
+/**
+ * @brief Initialize an array-backed stack for storing elements of a specified data type.
+ *
+ * Unlike RStack, which keeps the caller's pointers in linked nodes, this stack
+ * copies every element into one contiguous buffer that doubles like RDynArray,
+ * so pushing and popping only allocate when the buffer has to grow.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @return A pointer to the initialized stack, or NULL if the allocation failed.
+ */
+RArrayStack *rastack_init(size_t type_size);
+
+/**
+ * @brief Initialize an array-backed stack that uses a custom allocator.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param allocator The allocator to use, or NULL for malloc/realloc/free.
+ * @return A pointer to the initialized stack, or NULL if the allocation failed.
+ */
+RArrayStack *rastack_init_alloc(size_t type_size, const RAllocator *allocator);
+
+/**
+ * @brief Destroy an array-backed stack.
+ *
+ * @param stack A pointer to the RArrayStack to be destroyed.
+ */
+void rastack_destroy(RArrayStack *stack);
+
+/**
+ * @brief Copy an element onto the top of the stack.
+ *
+ * @param stack A pointer to the RArrayStack.
+ * @param data A pointer to the type_size bytes to be pushed.
+ * @return true on success, false if the stack could not grow.
+ */
+bool rastack_push(RArrayStack *stack, const void *data);
+
+/**
+ * @brief Remove the top element of the stack.
+ *
+ * @param stack A pointer to the RArrayStack.
+ * @param out Receives a copy of the removed element, or NULL to discard it.
+ * @return true if an element was removed, false if the stack was empty.
+ */
+bool rastack_pop(RArrayStack *stack, void *out);
+
+/**
+ * @brief Get the top element of the stack without removing it.
+ *
+ * @param stack A pointer to the RArrayStack.
+ * @return A pointer to the top element, valid until the next push or pop, or NULL if the stack is empty.
+ */
+void *rastack_top(const RArrayStack *stack);
+
+/**
+ * @brief Get the current size of the stack.
+ *
+ * @param stack A pointer to the RArrayStack.
+ * @return The number of elements in the stack.
+ */
+size_t rastack_get_size(const RArrayStack *stack);
+
+/**
+ * @brief Check if the stack is empty.
+ *
+ * @param stack A pointer to the RArrayStack.
+ * @return true if the stack is empty, false otherwise.
+ */
+bool rastack_is_empty(const RArrayStack *stack);
+
+/**
+ * @brief Print the contents of the stack from top to bottom.
+ *
+ * @param stack A pointer to the RArrayStack.
+ * @param print A function pointer to a function that prints an individual element.
+ */
+void rastack_print(const RArrayStack *stack, void (*print)(void *));
+
+#endif /* __RARRAYSTACK_H__ */
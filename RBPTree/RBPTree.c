@@ -0,0 +1,381 @@
+#include "RBPTree.h"
+#include "RAllocator.h"
+#include "RPool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Nodes are carved from slabs of this size, several nodes per slab. */
+#define RBPTREE_SLAB_SIZE (64 * 1024)
+
+/* Deep enough for any tree: every internal node but the root has at least two children. */
+#define RBPTREE_MAX_DEPTH 64
+
+/*
+ * Leaves hold up to leaf_capacity elements and link to the next leaf.
+ * Internal nodes hold up to inner_capacity separator keys followed, at
+ * child_offset, by count + 1 child pointers; child i covers the elements that
+ * are not less than key i - 1 and less than key i. Both kinds have room for
+ * one extra key (and child) so a full node can take the insert and split
+ * afterwards.
+ */
+typedef struct RBPNode
+{
+    uint32_t count;
+    uint32_t leaf;
+    struct RBPNode *next;
+    unsigned char keys[];
+} RBPNode;
+
+typedef struct RBPTree
+{
+    RBPNode *root;
+    RBPNode *head;
+    size_t size;
+    size_t type_size;
+    size_t leaf_capacity;
+    size_t inner_capacity;
+    size_t child_offset;
+    bool (*greater)(const void *, const void *);
+    bool (*less)(const void *, const void *);
+    unsigned char *separator;
+    RAllocator allocator;
+    RPool pool;
+} RBPTree;
+
+#define RBPNODE_KEY(tree, node, i) ((node)->keys + (size_t)(i) * (tree)->type_size)
+#define RBPNODE_CHILDREN(tree, node) ((RBPNode **)((node)->keys + (tree)->child_offset))
+
+static RBPNode *rbpnode_create(RBPTree *tree, bool leaf)
+{
+    RBPNode *node = (RBPNode *)rpool_alloc(&tree->pool);
+    if (node == NULL)
+        return (NULL);
+    node->count = 0;
+    node->leaf = leaf;
+    node->next = NULL;
+    return (node);
+}
+
+/* Index of the first key in node that is not less than key. */
+static size_t rbpnode_lower_bound(const RBPTree *tree, const RBPNode *node, const void *key)
+{
+    size_t lo = 0;
+    size_t hi = node->count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (tree->less(RBPNODE_KEY(tree, node, mid), key))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo);
+}
+
+/* Index of the first key in node that is greater than key, which is also the child to descend into. */
+static size_t rbpnode_upper_bound(const RBPTree *tree, const RBPNode *node, const void *key)
+{
+    size_t lo = 0;
+    size_t hi = node->count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (tree->less(key, RBPNODE_KEY(tree, node, mid)))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return (lo);
+}
+
+static RBPNode *rbptree_find_leaf(const RBPTree *tree, const void *key)
+{
+    RBPNode *node = tree->root;
+    while (node != NULL && !node->leaf)
+        node = RBPNODE_CHILDREN(tree, node)[rbpnode_upper_bound(tree, node, key)];
+    return (node);
+}
+
+/* Offset of the child pointers in an internal node: past inner_capacity + 1 keys, pointer-aligned. */
+static size_t rbptree_child_offset(size_t type_size, size_t inner_capacity)
+{
+    size_t pointer = sizeof(RBPNode *);
+    return (((inner_capacity + 1) * type_size + pointer - 1) / pointer * pointer);
+}
+
+RBPTree *rbptree_init(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *))
+{
+    return (rbptree_init_alloc(type_size, greater, less, NULL));
+}
+
+RBPTree *rbptree_init_alloc(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *),
+    const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RBPTree *tree = (RBPTree *)rallocator_alloc(allocator, sizeof(RBPTree));
+    if (tree == NULL)
+        return (NULL);
+    size_t header = offsetof(RBPNode, keys);
+    size_t pointer = sizeof(RBPNode *);
+    size_t space = RBPTREE_NODE_SIZE - header;
+
+    /* Each capacity leaves room for the one extra key a node holds just before it splits. */
+    tree->leaf_capacity = space / type_size;
+    tree->leaf_capacity = tree->leaf_capacity > RBPTREE_MIN_NODE_CAPACITY ? tree->leaf_capacity - 1 : RBPTREE_MIN_NODE_CAPACITY;
+    tree->inner_capacity = space / (type_size + pointer);
+    while (tree->inner_capacity > RBPTREE_MIN_NODE_CAPACITY
+        && rbptree_child_offset(type_size, tree->inner_capacity) + (tree->inner_capacity + 2) * pointer > space)
+        tree->inner_capacity--;
+    if (tree->inner_capacity < RBPTREE_MIN_NODE_CAPACITY)
+        tree->inner_capacity = RBPTREE_MIN_NODE_CAPACITY;
+    tree->child_offset = rbptree_child_offset(type_size, tree->inner_capacity);
+
+    /* Large element types need bigger nodes; keep them a whole number of cache lines. */
+    size_t leaf_size = header + (tree->leaf_capacity + 1) * type_size;
+    size_t inner_size = header + tree->child_offset + (tree->inner_capacity + 2) * pointer;
+    size_t node_size = leaf_size > inner_size ? leaf_size : inner_size;
+    node_size = (node_size + RPOOL_SLAB_ALIGN - 1) / RPOOL_SLAB_ALIGN * RPOOL_SLAB_ALIGN;
+
+    tree->root = NULL;
+    tree->head = NULL;
+    tree->size = 0;
+    tree->type_size = type_size;
+    tree->greater = greater;
+    tree->less = less;
+    tree->allocator = *allocator;
+    tree->separator = (unsigned char *)rallocator_alloc(allocator, type_size);
+    if (tree->separator == NULL)
+    {
+        rallocator_free(allocator, tree, sizeof(RBPTree));
+        return (NULL);
+    }
+    rpool_init(&tree->pool, node_size, RBPTREE_SLAB_SIZE, allocator);
+    return (tree);
+}
+
+void rbptree_destroy(RBPTree *tree)
+{
+    RAllocator allocator = tree->allocator;
+    rpool_release(&tree->pool);
+    rallocator_free(&allocator, tree->separator, tree->type_size);
+    rallocator_free(&allocator, tree, sizeof(RBPTree));
+}
+
+/*
+ * Take count nodes from the pool before the tree is touched, a leaf followed
+ * by internal nodes, so a failed allocation leaves the tree unchanged.
+ */
+static bool rbptree_reserve(RBPTree *tree, RBPNode **nodes, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        nodes[i] = rbpnode_create(tree, i == 0);
+        if (nodes[i] == NULL)
+        {
+            while (i > 0)
+                rpool_free(&tree->pool, nodes[--i]);
+            return (false);
+        }
+    }
+    return (true);
+}
+
+/* Move the keys of an overfull leaf past keep into the new leaf right; its first key becomes the separator. */
+static void rbptree_split_leaf(RBPTree *tree, RBPNode *leaf, RBPNode *right, size_t keep)
+{
+    right->count = leaf->count - (uint32_t)keep;
+    memcpy(right->keys, RBPNODE_KEY(tree, leaf, keep), right->count * tree->type_size);
+    leaf->count = (uint32_t)keep;
+    right->next = leaf->next;
+    leaf->next = right;
+    memcpy(tree->separator, right->keys, tree->type_size);
+}
+
+/* Move the keys and children past key keep into the new node right; key keep moves up as the separator. */
+static void rbptree_split_inner(RBPTree *tree, RBPNode *node, RBPNode *right, size_t keep)
+{
+    right->count = node->count - (uint32_t)keep - 1;
+    memcpy(tree->separator, RBPNODE_KEY(tree, node, keep), tree->type_size);
+    memcpy(right->keys, RBPNODE_KEY(tree, node, keep + 1), right->count * tree->type_size);
+    memcpy(RBPNODE_CHILDREN(tree, right), RBPNODE_CHILDREN(tree, node) + keep + 1,
+        (right->count + 1) * sizeof(RBPNode *));
+    node->count = (uint32_t)keep;
+}
+
+bool rbptree_insert(RBPTree *tree, const void *data)
+{
+    struct { RBPNode *node; size_t index; } path[RBPTREE_MAX_DEPTH];
+    size_t depth = 0;
+    bool append = true;
+
+    if (tree->root == NULL)
+    {
+        RBPNode *leaf = rbpnode_create(tree, true);
+        if (leaf == NULL)
+            return (false);
+        tree->root = tree->head = leaf;
+        memcpy(tree->root->keys, data, tree->type_size);
+        tree->root->count = 1;
+        tree->size = 1;
+        return (true);
+    }
+
+    RBPNode *node = tree->root;
+    while (!node->leaf)
+    {
+        size_t index = rbpnode_upper_bound(tree, node, data);
+        path[depth].node = node;
+        path[depth].index = index;
+        depth++;
+        append = append && index == node->count;
+        node = RBPNODE_CHILDREN(tree, node)[index];
+    }
+
+    size_t pos = rbpnode_lower_bound(tree, node, data);
+    if (pos < node->count && !tree->greater(RBPNODE_KEY(tree, node, pos), data))
+        return (false);
+
+    /* A full leaf splits, so does each full ancestor above it, and a full root adds a new root. */
+    RBPNode *spare[RBPTREE_MAX_DEPTH + 1];
+    size_t needed = 0;
+    if (node->count == tree->leaf_capacity)
+    {
+        size_t level = depth;
+        needed = 1;
+        while (level > 0 && path[level - 1].node->count == tree->inner_capacity)
+        {
+            level--;
+            needed++;
+        }
+        if (level == 0)
+            needed++;
+    }
+    if (!rbptree_reserve(tree, spare, needed))
+        return (false);
+
+    memmove(RBPNODE_KEY(tree, node, pos + 1), RBPNODE_KEY(tree, node, pos),
+        (node->count - pos) * tree->type_size);
+    memcpy(RBPNODE_KEY(tree, node, pos), data, tree->type_size);
+    node->count++;
+    tree->size++;
+    if (node->count <= tree->leaf_capacity)
+        return (true);
+
+    /*
+     * Split upwards: each split hands a separator and a new right sibling to
+     * the parent. Nodes are split in half, except when the element went past
+     * the end of the rightmost path; then the left nodes stay full, so
+     * ascending input fills nodes instead of leaving them half empty.
+     */
+    append = append && pos == node->count - 1;
+    RBPNode *right = spare[0];
+    size_t next = 1;
+    rbptree_split_leaf(tree, node, right, append ? node->count - 1 : node->count / 2);
+    while (depth > 0)
+    {
+        depth--;
+        RBPNode *parent = path[depth].node;
+        size_t index = path[depth].index;
+        RBPNode **children = RBPNODE_CHILDREN(tree, parent);
+
+        memmove(RBPNODE_KEY(tree, parent, index + 1), RBPNODE_KEY(tree, parent, index),
+            (parent->count - index) * tree->type_size);
+        memcpy(RBPNODE_KEY(tree, parent, index), tree->separator, tree->type_size);
+        memmove(children + index + 2, children + index + 1, (parent->count - index) * sizeof(RBPNode *));
+        children[index + 1] = right;
+        parent->count++;
+        if (parent->count <= tree->inner_capacity)
+            return (true);
+        right = spare[next++];
+        rbptree_split_inner(tree, parent, right, append ? parent->count - 2 : parent->count / 2);
+    }
+
+    RBPNode *root = spare[next];
+    memcpy(root->keys, tree->separator, tree->type_size);
+    RBPNODE_CHILDREN(tree, root)[0] = tree->root;
+    RBPNODE_CHILDREN(tree, root)[1] = right;
+    root->count = 1;
+    tree->root = root;
+    return (true);
+}
+
+void *rbptree_find(const RBPTree *tree, const void *key)
+{
+    RBPNode *leaf = rbptree_find_leaf(tree, key);
+    if (leaf == NULL)
+        return (NULL);
+
+    size_t pos = rbpnode_lower_bound(tree, leaf, key);
+    if (pos < leaf->count && !tree->greater(RBPNODE_KEY(tree, leaf, pos), key))
+        return (RBPNODE_KEY(tree, leaf, pos));
+    return (NULL);
+}
+
+bool rbptree_contains(const RBPTree *tree, const void *key)
+{
+    return (rbptree_find(tree, key) != NULL);
+}
+
+void *rbptree_lower_bound(const RBPTree *tree, const void *key)
+{
+    RBPNode *leaf = rbptree_find_leaf(tree, key);
+    if (leaf == NULL)
+        return (NULL);
+
+    size_t pos = rbpnode_lower_bound(tree, leaf, key);
+    if (pos == leaf->count)
+    {
+        /* Every key of this leaf is smaller; the answer is the first key of the next leaf. */
+        leaf = leaf->next;
+        pos = 0;
+    }
+    return (leaf != NULL ? RBPNODE_KEY(tree, leaf, pos) : NULL);
+}
+
+bool rbptree_visit_range(const RBPTree *tree, const void *lo, const void *hi,
+    bool (*visit)(void *data, void *context), void *context)
+{
+    RBPNode *leaf = rbptree_find_leaf(tree, lo);
+    if (leaf == NULL)
+        return (false);
+
+    size_t pos = rbpnode_lower_bound(tree, leaf, lo);
+    for (; leaf != NULL; leaf = leaf->next, pos = 0)
+    {
+        for (; pos < leaf->count; pos++)
+        {
+            void *data = RBPNODE_KEY(tree, leaf, pos);
+            if (!tree->less(data, hi))
+                return (false);
+            if (visit(data, context))
+                return (true);
+        }
+    }
+    return (false);
+}
+
+void rbptree_inorder(const RBPTree *tree, void (*print)(void *))
+{
+    for (RBPNode *leaf = tree->head; leaf != NULL; leaf = leaf->next)
+        for (size_t i = 0; i < leaf->count; i++)
+            print(RBPNODE_KEY(tree, leaf, i));
+}
+
+size_t rbptree_get_size(const RBPTree *tree)
+{
+    return (tree->size);
+}
+
+bool rbptree_is_empty(const RBPTree *tree)
+{
+    return (tree->size == 0);
+}
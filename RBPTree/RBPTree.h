@@ -0,0 +1,165 @@
+/**
+ * @file RBPTree.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RBPTREE_H__
+#define __RBPTREE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+/** Target size in bytes of one B+ tree node, header included. */
+#define RBPTREE_NODE_SIZE 256
+
+/** Minimum number of keys per node, used for large element types. */
+#define RBPTREE_MIN_NODE_CAPACITY 4
+
+/**
+ * @brief B+ tree structure definition.
+ *
+ * RBPTree is an ordered set built with the same greater/less comparators as
+ * RBTree, but elements are copied into the tree and packed by value into
+ * nodes of RBPTREE_NODE_SIZE bytes. A lookup searches inside each node, so it
+ * touches one node per level of a tree that is far shallower than a binary
+ * one, and no element has to be dereferenced through a separate pointer.
+ * All elements live in the leaves, which are linked in order for range scans.
+ * Element pointers returned by the tree point into the nodes and stay valid
+ * only until the tree is modified.
+ */
+struct RBPTree;
+
+/**
+ * @brief Typedef for RBPTree structure.
+ */
+typedef struct RBPTree RBPTree;
+
+/**
+ * @brief Initialize a B+ tree.
+ *
+ * This function initializes a B+ tree with the specified type size and
+ * comparison functions. Inserted elements are copied into the tree.
+ *
+ * @param type_size The size (in bytes) of the data type stored in the tree.
+ * @param greater A pointer to a function for determining if one element is greater than another.
+ * @param less A pointer to a function for determining if one element is less than another.
+ * @return A pointer to the initialized B+ tree, or NULL if the allocation failed.
+ */
+RBPTree *rbptree_init(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *));
+
+/**
+ * @brief Initialize a B+ tree that uses a custom allocator.
+ *
+ * Same as rbptree_init, but the tree and its nodes are obtained from the
+ * given allocator instead of malloc.
+ *
+ * @param type_size The size (in bytes) of the data type stored in the tree.
+ * @param greater A pointer to a function for determining if one element is greater than another.
+ * @param less A pointer to a function for determining if one element is less than another.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized B+ tree, or NULL if the allocation failed.
+ */
+RBPTree *rbptree_init_alloc(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *),
+    const RAllocator *allocator);
+
+/**
+ * @brief Destroy a B+ tree.
+ *
+ * This function deallocates the tree and every node in it.
+ *
+ * @param tree A pointer to the RBPTree to be destroyed.
+ */
+void rbptree_destroy(RBPTree *tree);
+
+/**
+ * @brief Insert an element into the B+ tree.
+ *
+ * This function copies type_size bytes from data into the tree in
+ * O(log n). Elements that compare equal to one already in the tree are not
+ * inserted.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @param data A pointer to the data to be inserted into the tree.
+ * @return true if the element was inserted, false if an equal element was already in the tree
+ *         or a node could not be allocated; the tree is unchanged in that case.
+ */
+bool rbptree_insert(RBPTree *tree, const void *data);
+
+/**
+ * @brief Find an element in the B+ tree.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @param key A pointer to data compared against the elements.
+ * @return A pointer to the stored element, or NULL if there is none.
+ */
+void *rbptree_find(const RBPTree *tree, const void *key);
+
+/**
+ * @brief Check if the B+ tree contains an element equal to key.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @param key A pointer to data compared against the elements.
+ * @return true if a matching element was found, otherwise false.
+ */
+bool rbptree_contains(const RBPTree *tree, const void *key);
+
+/**
+ * @brief Find the smallest element that is not less than key.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @param key A pointer to data compared against the elements.
+ * @return A pointer to the stored element, or NULL if every element is less than key.
+ */
+void *rbptree_lower_bound(const RBPTree *tree, const void *key);
+
+/**
+ * @brief Call a function on every element in the range [lo, hi).
+ *
+ * This function descends once to the leaf holding lo and then walks the
+ * linked leaves. Returning true from visit stops the traversal.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @param lo The inclusive lower bound of the range.
+ * @param hi The exclusive upper bound of the range.
+ * @param visit The function called for each element in the range.
+ * @param context A pointer passed unchanged to visit.
+ * @return true if visit stopped the traversal early, otherwise false.
+ */
+bool rbptree_visit_range(const RBPTree *tree, const void *lo, const void *hi,
+    bool (*visit)(void *data, void *context), void *context);
+
+/**
+ * @brief Perform an inorder traversal of the B+ tree.
+ *
+ * This function walks the linked leaves, calling the provided print function
+ * on each element in ascending order.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @param print A function pointer to a function that prints an individual element.
+ */
+void rbptree_inorder(const RBPTree *tree, void (*print)(void *));
+
+/**
+ * @brief Get the number of elements in the B+ tree.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @return The number of elements in the tree.
+ */
+size_t rbptree_get_size(const RBPTree *tree);
+
+/**
+ * @brief Check if the B+ tree is empty.
+ *
+ * @param tree A pointer to the RBPTree.
+ * @return true if the tree is empty, otherwise false.
+ */
+bool rbptree_is_empty(const RBPTree *tree);
+
+#endif //__RBPTREE_H__
@@ -3,30 +3,65 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
 #include "RBTree.h"
+#include "RAllocator.h"
+#include "RPool.h"
 
-typedef struct RNode
+/* A red-black tree with n < 2^63 nodes is less than 2 * 63 levels high. */
+#define RBTREE_MAX_HEIGHT 128
+
+typedef enum RColor { RBTREE_RED, RBTREE_BLACK } RColor;
+
+typedef struct RBNode
 {
     void *data;
-    struct RNode *left;
-    struct RNode *right;
-} RNode;
+    struct RBNode *left;
+    struct RBNode *right;
+    struct RBNode *parent;
+    size_t count; /* Nodes in this subtree, kept up to date only with RBTREE_ORDER_STATS. */
+    RColor color;
+    bool bulk; /* Part of a block from rbtree_build_sorted, freed with the tree. */
+} RBNode;
+
+/* A single allocation holding many nodes, released only when the tree is destroyed. */
+typedef struct RBNodeBlock
+{
+    struct RBNodeBlock *next;
+    size_t size;
+} RBNodeBlock;
 
 typedef struct RBTree
 {
-    RNode *root;
+    RBNode *root;
+    RBNodeBlock *blocks;
     size_t size;
     size_t type_size;
     bool (*greater)(const void *, const void *);
     bool (*less)(const void *, const void *);
+    int64_t (*compare)(const void *, const void *); /* Replaces greater and less when set. */
     void (*free_data)(void *);
+    RAllocator allocator;
+    unsigned flags;
+    RPool pool; /* Node chunks of an RBTREE_ARENA tree. */
 } RBTree;
 
-static RNode *rnode_init(void *data)
+static RBNode *rnode_init(RBTree *tree, void *data, RBNode *parent)
 {
-    RNode *node = (RNode *)malloc(sizeof(RNode));
+    RBNode *node;
+    if (tree->flags & RBTREE_ARENA)
+        node = (RBNode *)rpool_alloc(&tree->pool);
+    else
+        node = (RBNode *)rallocator_alloc(&tree->allocator, sizeof(RBNode));
+    if (node == NULL)
+        return (NULL);
     node->data = data;
     node->left = node->right = NULL;
+    node->parent = parent;
+    node->count = 1;
+    node->color = RBTREE_RED;
+    node->bulk = false;
     return (node);
 }
 
@@ -35,91 +70,1087 @@ RBTree *rbtree_init(size_t type_size,
     bool (*less)(const void *, const void *),
     void (*free_data)(void *))
 {
-    RBTree *tree = (RBTree *)malloc(sizeof(RBTree));
+    return (rbtree_init_alloc(type_size, greater, less, free_data, NULL));
+}
+
+RBTree *rbtree_init_alloc(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *),
+    void (*free_data)(void *),
+    const RAllocator *allocator)
+{
+    return (rbtree_init_ex(type_size, greater, less, free_data, 0, allocator));
+}
+
+static RBTree *rbtree_create(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *),
+    int64_t (*compare)(const void *, const void *),
+    void (*free_data)(void *),
+    unsigned flags,
+    const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RBTree *tree = (RBTree *)rallocator_alloc(allocator, sizeof(RBTree));
+    if (tree == NULL)
+        return (NULL);
+    tree->allocator = *allocator;
     tree->root = NULL;
+    tree->blocks = NULL;
     tree->size = 0;
     tree->type_size = type_size;
     tree->greater = greater;
     tree->less = less;
+    tree->compare = compare;
     tree->free_data = free_data;
+    tree->flags = flags;
+    rpool_init(&tree->pool, sizeof(RBNode), RBTREE_ARENA_CHUNK_SIZE, allocator);
     return (tree);
 }
 
-static void rbtree_destroy_node(RBTree *tree, RNode *node)
+RBTree *rbtree_init_ex(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *),
+    void (*free_data)(void *),
+    unsigned flags,
+    const RAllocator *allocator)
 {
-    if (node == NULL)
+    return (rbtree_create(type_size, greater, less, NULL, free_data, flags, allocator));
+}
+
+RBTree *rbtree_init_compare(size_t type_size,
+    int64_t (*compare)(const void *, const void *),
+    void (*free_data)(void *))
+{
+    return (rbtree_create(type_size, NULL, NULL, compare, free_data, 0, NULL));
+}
+
+RBTree *rbtree_init_compare_ex(size_t type_size,
+    int64_t (*compare)(const void *, const void *),
+    void (*free_data)(void *),
+    unsigned flags,
+    const RAllocator *allocator)
+{
+    return (rbtree_create(type_size, NULL, NULL, compare, free_data, flags, allocator));
+}
+
+/* Three-way comparison: one call with a comparator, otherwise less and, if needed, greater. */
+static inline int64_t rbtree_compare(const RBTree *tree, const void *a, const void *b)
+{
+    if (tree->compare != NULL)
+        return (tree->compare(a, b));
+    if (tree->less(a, b))
+        return (-1);
+    return (tree->greater(a, b) ? 1 : 0);
+}
+
+static inline bool rbtree_less(const RBTree *tree, const void *a, const void *b)
+{
+    if (tree->compare != NULL)
+        return (tree->compare(a, b) < 0);
+    return (tree->less(a, b));
+}
+
+static void rnode_free(RBTree *tree, RBNode *node)
+{
+    if (node->bulk)
         return;
-    
-    rbtree_destroy_node(tree, node->left);
-    rbtree_destroy_node(tree, node->right);
-    if (tree->free_data != NULL)
-        tree->free_data(node->data);
-    free(node);
+    if (tree->flags & RBTREE_ARENA)
+        rpool_free(&tree->pool, node);
+    else
+        rallocator_free(&tree->allocator, node, sizeof(RBNode));
+}
+
+static RBNode *rbtree_min_node(RBNode *node)
+{
+    if (node != NULL)
+        while (node->left != NULL)
+            node = node->left;
+    return (node);
+}
+
+static RBNode *rbtree_max_node(RBNode *node)
+{
+    if (node != NULL)
+        while (node->right != NULL)
+            node = node->right;
+    return (node);
+}
+
+/* The next node in order: the leftmost node of the right subtree, or the first ancestor reached from its left. */
+static RBNode *rbtree_next_node(RBNode *node)
+{
+    if (node->right != NULL)
+        return (rbtree_min_node(node->right));
+    while (node->parent != NULL && node == node->parent->right)
+        node = node->parent;
+    return (node->parent);
+}
+
+static RBNode *rbtree_prev_node(RBNode *node)
+{
+    if (node->left != NULL)
+        return (rbtree_max_node(node->left));
+    while (node->parent != NULL && node == node->parent->left)
+        node = node->parent;
+    return (node->parent);
+}
+
+/* The first node in postorder below node: keep descending, preferring the left child. */
+static RBNode *rbtree_postorder_first(RBNode *node)
+{
+    if (node == NULL)
+        return (NULL);
+    for (;;)
+    {
+        if (node->left != NULL)
+            node = node->left;
+        else if (node->right != NULL)
+            node = node->right;
+        else
+            return (node);
+    }
+}
+
+/* The next node in postorder. Only node's parent and sibling are read, so node may be freed afterwards. */
+static RBNode *rbtree_postorder_next(RBNode *node)
+{
+    RBNode *parent = node->parent;
+    if (parent != NULL && node == parent->left && parent->right != NULL)
+        return (rbtree_postorder_first(parent->right));
+    return (parent);
 }
 
 void rbtree_destroy(RBTree *tree)
 {
-    rbtree_destroy_node(tree, tree->root);
-    free(tree);
+    RAllocator allocator = tree->allocator;
+    bool arena = (tree->flags & RBTREE_ARENA) != 0;
+
+    /* Arena nodes go away with their chunks, so only free_data needs the walk. */
+    RBNode *node = (arena && tree->free_data == NULL) ? NULL : rbtree_postorder_first(tree->root);
+    while (node != NULL)
+    {
+        RBNode *next = rbtree_postorder_next(node);
+        if (tree->free_data != NULL)
+            tree->free_data(node->data);
+        if (!arena)
+            rnode_free(tree, node);
+        node = next;
+    }
+    rpool_release(&tree->pool);
+    while (tree->blocks != NULL)
+    {
+        RBNodeBlock *next = tree->blocks->next;
+        rallocator_free(&allocator, tree->blocks, tree->blocks->size);
+        tree->blocks = next;
+    }
+    rallocator_free(&allocator, tree, sizeof(RBTree));
 }
 
-static void rbtree_insert_node(RNode **root, void *data, 
-    bool (*greater)(const void *, const void *),
-    bool (*less)(const void *, const void *))
+/* Make child take node's place under node's parent. */
+static void rbtree_replace_child(RBTree *tree, RBNode *node, RBNode *child)
+{
+    if (node->parent == NULL)
+        tree->root = child;
+    else if (node == node->parent->left)
+        node->parent->left = child;
+    else
+        node->parent->right = child;
+    if (child != NULL)
+        child->parent = node->parent;
+}
+
+static size_t rbtree_count(const RBNode *node)
 {
-    RNode *node = rnode_init(data);
-    if (*root == NULL)
-        *root = node;
-    else if (*root != NULL && less(data, (*root)->data))
-        rbtree_insert_node(&(*root)->left, data, greater, less);
-    else if (root != NULL && greater(data, (*root)->data))
-        rbtree_insert_node(&(*root)->right, data, greater, less);
+    return (node != NULL ? node->count : 0);
 }
 
-void rbtree_insert(RBTree *tree, void *data)
+/* Add delta to the subtree count of node and all its ancestors. */
+static void rbtree_adjust_counts(RBNode *node, size_t delta)
 {
-    rbtree_insert_node(&tree->root, data, tree->greater, tree->less);
+    for (; node != NULL; node = node->parent)
+        node->count += delta;
+}
+
+/* After a rotation the pivot covers the old subtree and node only its new children. */
+static void rbtree_rotate_counts(const RBTree *tree, RBNode *node, RBNode *pivot)
+{
+    if (tree->flags & RBTREE_ORDER_STATS)
+    {
+        pivot->count = node->count;
+        node->count = 1 + rbtree_count(node->left) + rbtree_count(node->right);
+    }
+}
+
+static void rbtree_rotate_left(RBTree *tree, RBNode *node)
+{
+    RBNode *pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left != NULL)
+        pivot->left->parent = node;
+    rbtree_replace_child(tree, node, pivot);
+    pivot->left = node;
+    node->parent = pivot;
+    rbtree_rotate_counts(tree, node, pivot);
+}
+
+static void rbtree_rotate_right(RBTree *tree, RBNode *node)
+{
+    RBNode *pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right != NULL)
+        pivot->right->parent = node;
+    rbtree_replace_child(tree, node, pivot);
+    pivot->right = node;
+    node->parent = pivot;
+    rbtree_rotate_counts(tree, node, pivot);
+}
+
+/* Restore the red-black properties after node was inserted red. */
+static void rbtree_insert_fixup(RBTree *tree, RBNode *node)
+{
+    RBNode *parent;
+    while ((parent = node->parent) != NULL && parent->color == RBTREE_RED)
+    {
+        /* A red parent is never the root, so the grandparent exists. */
+        RBNode *grandparent = parent->parent;
+        if (parent == grandparent->left)
+        {
+            RBNode *uncle = grandparent->right;
+            if (uncle != NULL && uncle->color == RBTREE_RED)
+            {
+                parent->color = uncle->color = RBTREE_BLACK;
+                grandparent->color = RBTREE_RED;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->right)
+            {
+                rbtree_rotate_left(tree, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RBTREE_BLACK;
+            grandparent->color = RBTREE_RED;
+            rbtree_rotate_right(tree, grandparent);
+        }
+        else
+        {
+            RBNode *uncle = grandparent->left;
+            if (uncle != NULL && uncle->color == RBTREE_RED)
+            {
+                parent->color = uncle->color = RBTREE_BLACK;
+                grandparent->color = RBTREE_RED;
+                node = grandparent;
+                continue;
+            }
+            if (node == parent->left)
+            {
+                rbtree_rotate_right(tree, parent);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RBTREE_BLACK;
+            grandparent->color = RBTREE_RED;
+            rbtree_rotate_left(tree, grandparent);
+        }
+    }
+    tree->root->color = RBTREE_BLACK;
+}
+
+bool rbtree_insert(RBTree *tree, void *data)
+{
+    RBNode *parent = NULL;
+    RBNode **link = &tree->root;
+
+    while (*link != NULL)
+    {
+        parent = *link;
+        int64_t order = rbtree_compare(tree, data, parent->data);
+        if (order < 0)
+            link = &parent->left;
+        else if (order > 0)
+            link = &parent->right;
+        else
+            return (false);
+    }
+
+    RBNode *node = rnode_init(tree, data, parent);
+    if (node == NULL)
+        return (false);
+
+    *link = node;
     tree->size++;
+    if (tree->flags & RBTREE_ORDER_STATS)
+        rbtree_adjust_counts(parent, 1);
+    rbtree_insert_fixup(tree, node);
+    return (true);
 }
 
-static void rbtree_inorder_root(RNode *root, void (*print)(void *))
+/*
+ * Link nodes[lo, hi) into a balanced subtree rooted at the middle node. The
+ * subtrees of every node differ in size by at most one, so every empty link
+ * is at depth max_depth or max_depth + 1; colouring the nodes at max_depth
+ * red (unless every level is full) gives all paths the same number of black
+ * nodes without two reds in a row.
+ */
+static RBNode *rbtree_build_range(RBNode *nodes, size_t lo, size_t hi, RBNode *parent,
+    size_t depth, size_t red_depth)
 {
-    if (root == NULL)
-        return;
-    rbtree_inorder_root(root->left, print);
-    print(root->data);
-    rbtree_inorder_root(root->right, print);
+    if (lo >= hi)
+        return (NULL);
+
+    size_t mid = lo + (hi - lo) / 2;
+    RBNode *node = &nodes[mid];
+    node->parent = parent;
+    node->count = hi - lo;
+    node->color = depth == red_depth ? RBTREE_RED : RBTREE_BLACK;
+    node->left = rbtree_build_range(nodes, lo, mid, node, depth + 1, red_depth);
+    node->right = rbtree_build_range(nodes, mid + 1, hi, node, depth + 1, red_depth);
+    return (node);
 }
 
-void rbtree_inorder(RBTree *tree, void (*print)(void *))
+bool rbtree_build_sorted(RBTree *tree, void *elements, size_t count)
+{
+    unsigned char *bytes = (unsigned char *)elements;
+
+    if (tree->root != NULL)
+        return (false);
+    for (size_t i = 1; i < count; i++)
+        if (!rbtree_less(tree, bytes + (i - 1) * tree->type_size, bytes + i * tree->type_size))
+            return (false);
+    if (count == 0)
+        return (true);
+
+    size_t block_size = sizeof(RBNodeBlock) + count * sizeof(RBNode);
+    RBNodeBlock *block = (RBNodeBlock *)rallocator_alloc(&tree->allocator, block_size);
+    if (block == NULL)
+        return (false);
+    block->size = block_size;
+    block->next = tree->blocks;
+    tree->blocks = block;
+
+    RBNode *nodes = (RBNode *)(block + 1);
+    for (size_t i = 0; i < count; i++)
+    {
+        nodes[i].data = bytes + i * tree->type_size;
+        nodes[i].bulk = true;
+    }
+
+    size_t max_depth = 0;
+    while (((size_t)2 << max_depth) <= count)
+        max_depth++;
+    bool full = ((count + 1) & count) == 0;
+
+    tree->root = rbtree_build_range(nodes, 0, count, NULL, 0, full ? SIZE_MAX : max_depth);
+    tree->size = count;
+    return (true);
+}
+
+static RBNode *rbtree_find_node(const RBTree *tree, const void *key)
 {
-    rbtree_inorder_root(tree->root, print);
+    RBNode *node = tree->root;
+    while (node != NULL)
+    {
+        int64_t order = rbtree_compare(tree, key, node->data);
+        if (order < 0)
+            node = node->left;
+        else if (order > 0)
+            node = node->right;
+        else
+            return (node);
+    }
+    return (NULL);
 }
 
-static void rbtree_preorder_root(RNode *root, void (*print)(void *))
+static RBNode *rbtree_lower_bound_node(const RBTree *tree, const void *key)
 {
-    if (root == NULL)
-        return;
-    print(root->data);
-    rbtree_preorder_root(root->left, print);
-    rbtree_preorder_root(root->right, print);
+    RBNode *bound = NULL;
+    RBNode *node = tree->root;
+    while (node != NULL)
+    {
+        if (rbtree_less(tree, node->data, key))
+            node = node->right;
+        else
+        {
+            bound = node;
+            node = node->left;
+        }
+    }
+    return (bound);
+}
+
+static RBNode *rbtree_upper_bound_node(const RBTree *tree, const void *key)
+{
+    RBNode *bound = NULL;
+    RBNode *node = tree->root;
+    while (node != NULL)
+    {
+        if (rbtree_less(tree, key, node->data))
+        {
+            bound = node;
+            node = node->left;
+        }
+        else
+            node = node->right;
+    }
+    return (bound);
+}
+
+void *rbtree_find(const RBTree *tree, const void *key)
+{
+    RBNode *node = rbtree_find_node(tree, key);
+    return (node != NULL ? node->data : NULL);
+}
+
+bool rbtree_contains(const RBTree *tree, const void *key)
+{
+    return (rbtree_find_node(tree, key) != NULL);
+}
+
+void *rbtree_lower_bound(const RBTree *tree, const void *key)
+{
+    RBNode *node = rbtree_lower_bound_node(tree, key);
+    return (node != NULL ? node->data : NULL);
+}
+
+void *rbtree_upper_bound(const RBTree *tree, const void *key)
+{
+    RBNode *node = rbtree_upper_bound_node(tree, key);
+    return (node != NULL ? node->data : NULL);
+}
+
+void *rbtree_min(const RBTree *tree)
+{
+    RBNode *node = rbtree_min_node(tree->root);
+    return (node != NULL ? node->data : NULL);
+}
+
+void *rbtree_max(const RBTree *tree)
+{
+    RBNode *node = rbtree_max_node(tree->root);
+    return (node != NULL ? node->data : NULL);
+}
+
+bool rbtree_visit_range(const RBTree *tree, const void *lo, const void *hi,
+    bool (*visit)(void *data, void *context), void *context)
+{
+    for (RBNode *node = rbtree_lower_bound_node(tree, lo);
+        node != NULL && rbtree_less(tree, node->data, hi);
+        node = rbtree_next_node(node))
+    {
+        if (visit(node->data, context))
+            return (true);
+    }
+    return (false);
+}
+
+size_t rbtree_get_size(const RBTree *tree)
+{
+    return (tree->size);
+}
+
+bool rbtree_is_empty(const RBTree *tree)
+{
+    return (tree->size == 0);
+}
+
+/* Restore the red-black properties after a black node was unlinked above node (which may be NULL). */
+static void rbtree_remove_fixup(RBTree *tree, RBNode *node, RBNode *parent)
+{
+    while (node != tree->root && (node == NULL || node->color == RBTREE_BLACK))
+    {
+        /* The sibling subtree has a black height of at least one, so it is not empty. */
+        if (node == parent->left)
+        {
+            RBNode *sibling = parent->right;
+            if (sibling->color == RBTREE_RED)
+            {
+                sibling->color = RBTREE_BLACK;
+                parent->color = RBTREE_RED;
+                rbtree_rotate_left(tree, parent);
+                sibling = parent->right;
+            }
+            if ((sibling->left == NULL || sibling->left->color == RBTREE_BLACK)
+                && (sibling->right == NULL || sibling->right->color == RBTREE_BLACK))
+            {
+                sibling->color = RBTREE_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (sibling->right == NULL || sibling->right->color == RBTREE_BLACK)
+            {
+                sibling->left->color = RBTREE_BLACK;
+                sibling->color = RBTREE_RED;
+                rbtree_rotate_right(tree, sibling);
+                sibling = parent->right;
+            }
+            sibling->color = parent->color;
+            parent->color = RBTREE_BLACK;
+            sibling->right->color = RBTREE_BLACK;
+            rbtree_rotate_left(tree, parent);
+        }
+        else
+        {
+            RBNode *sibling = parent->left;
+            if (sibling->color == RBTREE_RED)
+            {
+                sibling->color = RBTREE_BLACK;
+                parent->color = RBTREE_RED;
+                rbtree_rotate_right(tree, parent);
+                sibling = parent->left;
+            }
+            if ((sibling->left == NULL || sibling->left->color == RBTREE_BLACK)
+                && (sibling->right == NULL || sibling->right->color == RBTREE_BLACK))
+            {
+                sibling->color = RBTREE_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (sibling->left == NULL || sibling->left->color == RBTREE_BLACK)
+            {
+                sibling->right->color = RBTREE_BLACK;
+                sibling->color = RBTREE_RED;
+                rbtree_rotate_left(tree, sibling);
+                sibling = parent->left;
+            }
+            sibling->color = parent->color;
+            parent->color = RBTREE_BLACK;
+            sibling->left->color = RBTREE_BLACK;
+            rbtree_rotate_right(tree, parent);
+        }
+        node = tree->root;
+    }
+    if (node != NULL)
+        node->color = RBTREE_BLACK;
+}
+
+/*
+ * Unlink node from the tree and rebalance. A node with two children is
+ * replaced by its in-order successor, which is relinked in its place rather
+ * than having its data copied, so other nodes never change which element
+ * they hold.
+ */
+static void rbtree_unlink_node(RBTree *tree, RBNode *node)
+{
+    RBNode *child;
+    RBNode *parent;
+    RColor removed_color;
+
+    /*
+     * Only the position node or its successor leaves is removed; every node
+     * on the path above it, node included, loses one element. The successor
+     * then takes over node's (already decremented) count.
+     */
+    if (tree->flags & RBTREE_ORDER_STATS)
+    {
+        RBNode *removed = node;
+        if (node->left != NULL && node->right != NULL)
+            removed = rbtree_min_node(node->right);
+        rbtree_adjust_counts(removed->parent, (size_t)-1);
+    }
+
+    if (node->left == NULL || node->right == NULL)
+    {
+        child = node->left != NULL ? node->left : node->right;
+        parent = node->parent;
+        removed_color = node->color;
+        rbtree_replace_child(tree, node, child);
+    }
+    else
+    {
+        RBNode *successor = rbtree_min_node(node->right);
+        child = successor->right;
+        removed_color = successor->color;
+        if (successor->parent == node)
+            parent = successor;
+        else
+        {
+            parent = successor->parent;
+            rbtree_replace_child(tree, successor, child);
+            successor->right = node->right;
+            successor->right->parent = successor;
+        }
+        rbtree_replace_child(tree, node, successor);
+        successor->left = node->left;
+        successor->left->parent = successor;
+        successor->color = node->color;
+        successor->count = node->count;
+    }
+
+    tree->size--;
+    if (removed_color == RBTREE_BLACK)
+        rbtree_remove_fixup(tree, child, parent);
+}
+
+bool rbtree_remove(RBTree *tree, const void *element)
+{
+    RBNode *node = rbtree_find_node(tree, element);
+    if (node == NULL)
+        return (false);
+
+    void *data = node->data;
+    rbtree_unlink_node(tree, node);
+    rnode_free(tree, node);
+    if (tree->free_data != NULL)
+        tree->free_data(data);
+    return (true);
+}
+
+static void *rbtree_pop_node(RBTree *tree, RBNode *node)
+{
+    if (node == NULL)
+        return (NULL);
+
+    void *data = node->data;
+    rbtree_unlink_node(tree, node);
+    rnode_free(tree, node);
+    return (data);
+}
+
+void *rbtree_pop_min(RBTree *tree)
+{
+    return (rbtree_pop_node(tree, rbtree_min_node(tree->root)));
+}
+
+void *rbtree_pop_max(RBTree *tree)
+{
+    return (rbtree_pop_node(tree, rbtree_max_node(tree->root)));
+}
+
+void *rbtree_select(const RBTree *tree, size_t k)
+{
+    if (k >= tree->size)
+        return (NULL);
+
+    if (!(tree->flags & RBTREE_ORDER_STATS))
+    {
+        RBNode *node = rbtree_min_node(tree->root);
+        while (k-- > 0)
+            node = rbtree_next_node(node);
+        return (node->data);
+    }
+
+    RBNode *node = tree->root;
+    for (;;)
+    {
+        size_t left = rbtree_count(node->left);
+        if (k < left)
+            node = node->left;
+        else if (k == left)
+            return (node->data);
+        else
+        {
+            k -= left + 1;
+            node = node->right;
+        }
+    }
+}
+
+size_t rbtree_rank(const RBTree *tree, const void *key)
+{
+    size_t rank = 0;
+
+    if (!(tree->flags & RBTREE_ORDER_STATS))
+    {
+        for (RBNode *node = rbtree_min_node(tree->root); node != NULL && rbtree_less(tree, node->data, key);
+             node = rbtree_next_node(node))
+            rank++;
+        return (rank);
+    }
+
+    RBNode *node = tree->root;
+    while (node != NULL)
+    {
+        if (rbtree_less(tree, node->data, key))
+        {
+            rank += rbtree_count(node->left) + 1;
+            node = node->right;
+        }
+        else
+            node = node->left;
+    }
+    return (rank);
+}
+
+size_t rbtree_count_range(const RBTree *tree, const void *lo, const void *hi)
+{
+    if (!rbtree_less(tree, lo, hi))
+        return (0);
+    return (rbtree_rank(tree, hi) - rbtree_rank(tree, lo));
+}
+
+/*
+ * The full traversals keep the path in an explicit stack rather than
+ * stepping through parent pointers: climbing back up costs extra dependent
+ * loads per element, while the stack stays in L1.
+ */
+bool rbtree_visit_inorder(const RBTree *tree, bool (*visit)(void *data, void *context), void *context)
+{
+    RBNode *stack[RBTREE_MAX_HEIGHT];
+    size_t depth = 0;
+    RBNode *node = tree->root;
+
+    while (node != NULL || depth > 0)
+    {
+        for (; node != NULL; node = node->left)
+            stack[depth++] = node;
+        node = stack[--depth];
+        if (visit(node->data, context))
+            return (true);
+        node = node->right;
+    }
+    return (false);
+}
+
+bool rbtree_visit_preorder(const RBTree *tree, bool (*visit)(void *data, void *context), void *context)
+{
+    RBNode *stack[RBTREE_MAX_HEIGHT];
+    size_t depth = 0;
+
+    if (tree->root != NULL)
+        stack[depth++] = tree->root;
+    while (depth > 0)
+    {
+        RBNode *node = stack[--depth];
+        if (visit(node->data, context))
+            return (true);
+        if (node->right != NULL)
+            stack[depth++] = node->right;
+        if (node->left != NULL)
+            stack[depth++] = node->left;
+    }
+    return (false);
+}
+
+bool rbtree_visit_postorder(const RBTree *tree, bool (*visit)(void *data, void *context), void *context)
+{
+    RBNode *stack[RBTREE_MAX_HEIGHT];
+    size_t depth = 0;
+    RBNode *node = tree->root;
+    RBNode *last = NULL;
+
+    while (node != NULL || depth > 0)
+    {
+        if (node != NULL)
+        {
+            stack[depth++] = node;
+            node = node->left;
+            continue;
+        }
+
+        RBNode *top = stack[depth - 1];
+        if (top->right != NULL && top->right != last)
+            node = top->right;
+        else
+        {
+            if (visit(top->data, context))
+                return (true);
+            last = top;
+            depth--;
+        }
+    }
+    return (false);
+}
+
+typedef struct RBTreePrint { void (*print)(void *); } RBTreePrint;
+
+static bool rbtree_print_visit(void *data, void *context)
+{
+    ((RBTreePrint *)context)->print(data);
+    return (false);
+}
+
+void rbtree_inorder(RBTree *tree, void (*print)(void *))
+{
+    RBTreePrint context = { print };
+    rbtree_visit_inorder(tree, rbtree_print_visit, &context);
 }
 
 void rbtree_preorder(RBTree *tree, void (*print)(void *))
 {
-    rbtree_preorder_root(tree->root, print);
+    RBTreePrint context = { print };
+    rbtree_visit_preorder(tree, rbtree_print_visit, &context);
+}
+
+void rbtree_postorder(RBTree *tree, void (*print)(void *))
+{
+    RBTreePrint context = { print };
+    rbtree_visit_postorder(tree, rbtree_print_visit, &context);
 }
 
-static void rbtree_postorder_root(RNode *root, void (*print)(void *))
+/* Tasks per thread when splitting a tree, so a thread that drew small subtrees takes more of them. */
+#define RBTREE_PARALLEL_TASKS_PER_THREAD 8
+#define RBTREE_CACHE_LINE 64
+
+/* A unit of parallel work: a whole subtree, or a single node above the split depth. */
+typedef struct RBTreeTask
+{
+    RBNode *node;
+    bool single;
+} RBTreeTask;
+
+typedef struct RBTreeParallel
+{
+    const RBTreeReducer *reducer;
+    RBTreeTask *tasks;
+    size_t task_count;
+    atomic_size_t next_task;
+    unsigned char *partials;
+    size_t stride;
+    bool ordered;
+} RBTreeParallel;
+
+typedef struct RBTreeWorker
 {
-    if (root == NULL)
+    RBTreeParallel *shared;
+    size_t index;
+} RBTreeWorker;
+
+/* Record the tasks of the subtree at node in order: nodes above the split depth become single tasks. */
+static void rbtree_split_tasks(RBNode *node, size_t depth, RBTreeTask *tasks, size_t *count)
+{
+    if (node == NULL)
+        return;
+    if (depth == 0)
+    {
+        tasks[*count].node = node;
+        tasks[(*count)++].single = false;
         return;
-    rbtree_postorder_root(root->left, print);
-    rbtree_postorder_root(root->right, print);
-    print(root->data);
+    }
+    rbtree_split_tasks(node->left, depth - 1, tasks, count);
+    tasks[*count].node = node;
+    tasks[(*count)++].single = true;
+    rbtree_split_tasks(node->right, depth - 1, tasks, count);
 }
 
-void rbtree_postorder(RBTree *tree, void (*print)(void *))
+static void rbtree_accumulate_task(const RBTreeReducer *reducer, const RBTreeTask *task, void *partial)
+{
+    RBNode *stack[RBTREE_MAX_HEIGHT];
+    size_t depth = 0;
+    RBNode *node = task->node;
+
+    if (task->single)
+    {
+        reducer->accumulate(partial, node->data, reducer->context);
+        return;
+    }
+    while (node != NULL || depth > 0)
+    {
+        for (; node != NULL; node = node->left)
+            stack[depth++] = node;
+        node = stack[--depth];
+        reducer->accumulate(partial, node->data, reducer->context);
+        node = node->right;
+    }
+}
+
+static void rbtree_reset_partial(const RBTreeReducer *reducer, void *partial)
+{
+    if (reducer->init != NULL)
+        reducer->init(partial, reducer->context);
+    else if (reducer->partial_size > 0)
+        memset(partial, 0, reducer->partial_size);
+}
+
+static void *rbtree_parallel_worker(void *arg)
+{
+    RBTreeWorker *worker = (RBTreeWorker *)arg;
+    RBTreeParallel *shared = worker->shared;
+    void *partial = NULL;
+
+    if (!shared->ordered)
+    {
+        partial = shared->partials + worker->index * shared->stride;
+        rbtree_reset_partial(shared->reducer, partial);
+    }
+
+    for (;;)
+    {
+        size_t i = atomic_fetch_add_explicit(&shared->next_task, 1, memory_order_relaxed);
+        if (i >= shared->task_count)
+            break;
+        if (shared->ordered)
+        {
+            partial = shared->partials + i * shared->stride;
+            rbtree_reset_partial(shared->reducer, partial);
+        }
+        rbtree_accumulate_task(shared->reducer, &shared->tasks[i], partial);
+    }
+    return (NULL);
+}
+
+static bool rbtree_parallel_run(const RBTree *tree, size_t threads, const RBTreeReducer *reducer,
+    void *result, bool ordered)
+{
+    const RAllocator *allocator = &tree->allocator;
+    size_t target = (threads > 1 ? threads : 1) * RBTREE_PARALLEL_TASKS_PER_THREAD;
+    size_t split_depth = 0;
+
+    while (((size_t)1 << split_depth) < target)
+        split_depth++;
+
+    /* At most 2^(depth + 1) - 1 nodes sit at or above the split depth. */
+    size_t max_tasks = ((size_t)2 << split_depth) - 1;
+    size_t tasks_size = max_tasks * sizeof(RBTreeTask);
+    RBTreeTask *tasks = (RBTreeTask *)rallocator_alloc(allocator, tasks_size);
+    if (tasks == NULL)
+        return (false);
+
+    size_t task_count = 0;
+    rbtree_split_tasks(tree->root, split_depth, tasks, &task_count);
+    if (threads > task_count)
+        threads = task_count;
+    if (threads == 0)
+        threads = 1;
+
+    /* Each partial gets its own cache lines so threads never write to a shared line. */
+    size_t stride = (reducer->partial_size + RBTREE_CACHE_LINE - 1) & ~(size_t)(RBTREE_CACHE_LINE - 1);
+    size_t partial_count = ordered ? task_count : threads;
+    size_t block_size = partial_count * stride + RBTREE_CACHE_LINE - 1;
+    size_t workers_size = threads * (sizeof(RBTreeWorker) + sizeof(pthread_t));
+    void *block = rallocator_alloc(allocator, block_size);
+    RBTreeWorker *workers = (RBTreeWorker *)rallocator_alloc(allocator, workers_size);
+    if (block == NULL || workers == NULL)
+    {
+        if (block != NULL)
+            rallocator_free(allocator, block, block_size);
+        if (workers != NULL)
+            rallocator_free(allocator, workers, workers_size);
+        rallocator_free(allocator, tasks, tasks_size);
+        return (false);
+    }
+    pthread_t *handles = (pthread_t *)(workers + threads);
+
+    RBTreeParallel shared;
+    shared.reducer = reducer;
+    shared.tasks = tasks;
+    shared.task_count = task_count;
+    atomic_init(&shared.next_task, 0);
+    shared.partials = (unsigned char *)(((uintptr_t)block + RBTREE_CACHE_LINE - 1) & ~(uintptr_t)(RBTREE_CACHE_LINE - 1));
+    shared.stride = stride;
+    shared.ordered = ordered;
+
+    /* The calling thread is worker 0; if a thread cannot be started the others pick up its tasks. */
+    size_t started = 1;
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers[i].shared = &shared;
+        workers[i].index = i;
+    }
+    for (size_t i = 1; i < threads; i++)
+    {
+        if (pthread_create(&handles[i], NULL, rbtree_parallel_worker, &workers[i]) != 0)
+            break;
+        started++;
+    }
+    rbtree_parallel_worker(&workers[0]);
+    for (size_t i = 1; i < started; i++)
+        pthread_join(handles[i], NULL);
+
+    /* Workers that were never started have no partial to combine. */
+    if (!ordered)
+        partial_count = started;
+    rbtree_reset_partial(reducer, result);
+    for (size_t i = 0; i < partial_count; i++)
+        reducer->combine(result, shared.partials + i * stride, reducer->context);
+
+    rallocator_free(allocator, workers, workers_size);
+    rallocator_free(allocator, block, block_size);
+    rallocator_free(allocator, tasks, tasks_size);
+    return (true);
+}
+
+bool rbtree_parallel_reduce(const RBTree *tree, size_t threads, const RBTreeReducer *reducer, void *result)
+{
+    return (rbtree_parallel_run(tree, threads, reducer, result, false));
+}
+
+bool rbtree_parallel_reduce_ordered(const RBTree *tree, size_t threads, const RBTreeReducer *reducer, void *result)
+{
+    return (rbtree_parallel_run(tree, threads, reducer, result, true));
+}
+
+typedef struct RBTreeParallelVisit
+{
+    void (*visit)(void *data, void *context);
+    void *context;
+} RBTreeParallelVisit;
+
+static void rbtree_parallel_visit_accumulate(void *partial, void *data, void *context)
+{
+    (void)partial;
+    RBTreeParallelVisit *adapter = (RBTreeParallelVisit *)context;
+    adapter->visit(data, adapter->context);
+}
+
+static void rbtree_parallel_visit_combine(void *result, const void *partial, void *context)
+{
+    (void)result;
+    (void)partial;
+    (void)context;
+}
+
+bool rbtree_parallel_visit(const RBTree *tree, size_t threads, void (*visit)(void *data, void *context), void *context)
+{
+    RBTreeParallelVisit adapter = { visit, context };
+    RBTreeReducer reducer;
+    reducer.partial_size = 0;
+    reducer.init = NULL;
+    reducer.accumulate = rbtree_parallel_visit_accumulate;
+    reducer.combine = rbtree_parallel_visit_combine;
+    reducer.context = &adapter;
+    return (rbtree_parallel_run(tree, threads, &reducer, NULL, false));
+}
+
+RBTreeIter rbtree_iter_begin(const RBTree *tree)
+{
+    RBTreeIter iter;
+    iter.tree = tree;
+    iter.node = rbtree_min_node(tree->root);
+    return (iter);
+}
+
+RBTreeIter rbtree_iter_last(const RBTree *tree)
+{
+    RBTreeIter iter;
+    iter.tree = tree;
+    iter.node = rbtree_max_node(tree->root);
+    return (iter);
+}
+
+RBTreeIter rbtree_iter_lower_bound(const RBTree *tree, const void *key)
+{
+    RBTreeIter iter;
+    iter.tree = tree;
+    iter.node = rbtree_lower_bound_node(tree, key);
+    return (iter);
+}
+
+bool rbtree_iter_valid(const RBTreeIter *iter)
+{
+    return (iter->node != NULL);
+}
+
+void *rbtree_iter_get(const RBTreeIter *iter)
+{
+    return (iter->node != NULL ? iter->node->data : NULL);
+}
+
+void rbtree_iter_next(RBTreeIter *iter)
+{
+    if (iter->node != NULL)
+        iter->node = rbtree_next_node(iter->node);
+}
+
+void rbtree_iter_prev(RBTreeIter *iter)
 {
-    rbtree_postorder_root(tree->root, print);
+    if (iter->node != NULL)
+        iter->node = rbtree_prev_node(iter->node);
+    else
+        iter->node = rbtree_max_node(iter->tree->root);
 }
@@ -7,8 +7,18 @@
 #ifndef __RBTREE_H__
 #define __RBTREE_H__
 
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "RAllocator.h"
+
 /**
  * @brief Binary tree structure definition.
+ *
+ * The tree is a red-black tree: every insertion rebalances it with
+ * recolourings and rotations, so its height stays below 2 * log2(n + 1) even
+ * when elements arrive in sorted order.
  */
 struct RBTree;
 
@@ -17,6 +27,68 @@ struct RBTree;
  */
 typedef struct RBTree RBTree;
 
+struct RBNode;
+
+/**
+ * @brief Flag for rbtree_init_ex: carve nodes from large chunks owned by the tree.
+ *
+ * Nodes are taken from RBTREE_ARENA_CHUNK_SIZE byte chunks and removed nodes
+ * are reused by later insertions. The chunks are only released when the tree
+ * is destroyed, and if the tree has no free_data function that is all
+ * rbtree_destroy does, without visiting the nodes. Nodes inserted together also
+ * sit next to each other in memory, which helps traversals.
+ */
+#define RBTREE_ARENA 0x1u
+
+/**
+ * @brief Flag for rbtree_init_ex: keep subtree sizes for order statistics.
+ *
+ * Every node records the number of nodes below it, updated along the path on
+ * insertion and removal and on each rotation, so rbtree_select, rbtree_rank
+ * and rbtree_count_range run in O(log n) instead of walking the elements.
+ */
+#define RBTREE_ORDER_STATS 0x2u
+
+/**
+ * @brief Size in bytes of the node chunks of an RBTREE_ARENA tree.
+ */
+#define RBTREE_ARENA_CHUNK_SIZE (64 * 1024)
+
+/**
+ * @brief Position inside a tree for in-order traversal in either direction.
+ *
+ * An iterator is a small value created by rbtree_iter_begin, rbtree_iter_last
+ * or rbtree_iter_lower_bound and moved with rbtree_iter_next and
+ * rbtree_iter_prev. Each step follows parent pointers, costing O(1) amortised
+ * and no extra memory, though climbing back to ancestors makes a full walk
+ * slower than rbtree_visit_inorder. The members are private; they are only
+ * visible so the iterator can live on the stack. Inserting into or removing from the tree
+ * invalidates it.
+ */
+typedef struct RBTreeIter
+{
+    const RBTree *tree;
+    struct RBNode *node;
+} RBTreeIter;
+
+/**
+ * @brief Callbacks describing a parallel reduction over a tree.
+ *
+ * Every thread starts from a partial result of partial_size bytes set up by
+ * init, folds elements into it with accumulate, and the partials are then
+ * merged into the caller's result with combine. accumulate may run on several
+ * threads at once, each with its own partial; init and combine see one
+ * partial at a time. If init is NULL the partials are zero-filled.
+ */
+typedef struct RBTreeReducer
+{
+    size_t partial_size;
+    void (*init)(void *partial, void *context);
+    void (*accumulate)(void *partial, void *data, void *context);
+    void (*combine)(void *result, const void *partial, void *context);
+    void *context;
+} RBTreeReducer;
+
 /**
  * @brief Initialize a binary tree.
  *
@@ -28,18 +100,94 @@ typedef struct RBTree RBTree;
  * @param greater A pointer to a function for determining if one element is greater than another.
  * @param less A pointer to a function for determining if one element is less than another.
  * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
- * @return A pointer to the initialized binary tree.
+ * @return A pointer to the initialized binary tree, or NULL if the allocation failed.
  */
 RBTree *rbtree_init(size_t type_size,
     bool (*greater)(const void *, const void *),
     bool (*less)(const void *, const void *),
     void (*free_data)(void *));
 
+/**
+ * @brief Initialize a binary tree that uses a custom allocator.
+ *
+ * Same as rbtree_init, but the tree and its nodes are obtained from the given
+ * allocator instead of malloc.
+ *
+ * @param type_size The size (in bytes) of the data type stored in the tree.
+ * @param greater A pointer to a function for determining if one element is greater than another.
+ * @param less A pointer to a function for determining if one element is less than another.
+ * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized binary tree, or NULL if the allocation failed.
+ */
+RBTree *rbtree_init_alloc(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *),
+    void (*free_data)(void *),
+    const RAllocator *allocator);
+
+/**
+ * @brief Initialize a binary tree with options.
+ *
+ * Same as rbtree_init_alloc, with flags selecting how the tree works.
+ *
+ * @param type_size The size (in bytes) of the data type stored in the tree.
+ * @param greater A pointer to a function for determining if one element is greater than another.
+ * @param less A pointer to a function for determining if one element is less than another.
+ * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
+ * @param flags 0 or a combination of RBTREE_ARENA and RBTREE_ORDER_STATS.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized binary tree, or NULL if the allocation failed.
+ */
+RBTree *rbtree_init_ex(size_t type_size,
+    bool (*greater)(const void *, const void *),
+    bool (*less)(const void *, const void *),
+    void (*free_data)(void *),
+    unsigned flags,
+    const RAllocator *allocator);
+
+/**
+ * @brief Initialize a binary tree ordered by a three-way comparator.
+ *
+ * Same as rbtree_init, but the order comes from a single function returning
+ * a negative value if a sorts before b, zero if they are equal and a positive
+ * value if a sorts after b. Each step of an insertion or lookup then costs one
+ * indirect call instead of up to two. For a fixed key type, RBTreeT.h
+ * generates a tree with the comparison inlined.
+ *
+ * @param type_size The size (in bytes) of the data type stored in the tree.
+ * @param compare A pointer to the three-way comparison function.
+ * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
+ * @return A pointer to the initialized binary tree, or NULL if the allocation failed.
+ */
+RBTree *rbtree_init_compare(size_t type_size,
+    int64_t (*compare)(const void *, const void *),
+    void (*free_data)(void *));
+
+/**
+ * @brief Initialize a binary tree ordered by a three-way comparator, with options.
+ *
+ * Same as rbtree_init_compare, with the flags and allocator of rbtree_init_ex.
+ *
+ * @param type_size The size (in bytes) of the data type stored in the tree.
+ * @param compare A pointer to the three-way comparison function.
+ * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
+ * @param flags 0 or a combination of RBTREE_ARENA and RBTREE_ORDER_STATS.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized binary tree, or NULL if the allocation failed.
+ */
+RBTree *rbtree_init_compare_ex(size_t type_size,
+    int64_t (*compare)(const void *, const void *),
+    void (*free_data)(void *),
+    unsigned flags,
+    const RAllocator *allocator);
+
 /**
  * @brief Destroy a binary tree.
  *
  * This function deallocates the memory occupied by the binary tree,
- * including the memory occupied by its elements.
+ * including the memory occupied by its elements. An RBTREE_ARENA tree
+ * without a free_data function is released in O(chunks) instead of O(n).
  *
  * @param tree A pointer to the BinaryTree to be destroyed.
  */
@@ -48,28 +196,204 @@ void rbtree_destroy(RBTree *tree);
 /**
  * @brief Insert an element into the binary tree.
  *
- * This function inserts a new element into the binary tree.
+ * This function inserts a new element into the binary tree in O(log n).
+ * Elements that compare equal to one already in the tree are not inserted.
  *
  * @param tree A pointer to the BinaryTree.
  * @param data A pointer to the data to be inserted into the tree.
+ * @return true if the element was inserted, false if an equal element was already in the tree
+ *         or the allocation failed.
  */
-void rbtree_insert(RBTree *tree, void *data);
+bool rbtree_insert(RBTree *tree, void *data);
+
+/**
+ * @brief Build the tree from elements that are already sorted.
+ *
+ * This function links count elements of type_size bytes, stored contiguously
+ * in ascending order (for example an RDynArray, starting at
+ * rdarray_get(array, 0)), into a balanced tree in O(n) time using a single
+ * allocation for all nodes. Like rbtree_insert, the tree stores pointers into
+ * the buffer, which must outlive the tree. The nodes are released together
+ * when the tree is destroyed; removing elements leaves their nodes in place
+ * until then.
+ *
+ * @param tree A pointer to an empty BinaryTree.
+ * @param elements A pointer to the first element.
+ * @param count The number of elements.
+ * @return true on success, false if the tree is not empty, the elements are
+ * not strictly ascending, or the allocation failed.
+ */
+bool rbtree_build_sorted(RBTree *tree, void *elements, size_t count);
 
 /**
  * @brief Remove an element from the binary tree.
  *
- * This function removes an element from the binary tree based on the provided data.
+ * This function removes the element that compares equal to the provided data
+ * in O(log n), rebalancing the tree, and passes the removed element to
+ * free_data if the tree has one.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param element A pointer to data compared against the elements.
+ * @return true if an element was removed, false if no element matched.
+ */
+bool rbtree_remove(RBTree *tree, const void *element);
+
+/**
+ * @brief Remove and return the smallest element of the binary tree.
+ *
+ * This function runs in O(log n). The element is handed back to the caller
+ * and is not passed to free_data.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return A pointer to the removed element, or NULL if the tree is empty.
+ */
+void *rbtree_pop_min(RBTree *tree);
+
+/**
+ * @brief Remove and return the largest element of the binary tree.
+ *
+ * This function runs in O(log n). The element is handed back to the caller
+ * and is not passed to free_data.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return A pointer to the removed element, or NULL if the tree is empty.
+ */
+void *rbtree_pop_max(RBTree *tree);
+
+/**
+ * @brief Find an element in the binary tree.
+ *
+ * This function searches from the root in O(log n). An element matches when
+ * it is neither less than nor greater than key.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param key A pointer to data compared against the elements.
+ * @return A pointer to the matching element, or NULL if there is none.
+ */
+void *rbtree_find(const RBTree *tree, const void *key);
+
+/**
+ * @brief Check if the binary tree contains an element equal to key.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param key A pointer to data compared against the elements.
+ * @return true if a matching element was found, otherwise false.
+ */
+bool rbtree_contains(const RBTree *tree, const void *key);
+
+/**
+ * @brief Find the smallest element that is not less than key.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param key A pointer to data compared against the elements.
+ * @return A pointer to the element, or NULL if every element is less than key.
+ */
+void *rbtree_lower_bound(const RBTree *tree, const void *key);
+
+/**
+ * @brief Find the smallest element that is greater than key.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param key A pointer to data compared against the elements.
+ * @return A pointer to the element, or NULL if no element is greater than key.
+ */
+void *rbtree_upper_bound(const RBTree *tree, const void *key);
+
+/**
+ * @brief Get the smallest element of the binary tree.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return A pointer to the smallest element, or NULL if the tree is empty.
+ */
+void *rbtree_min(const RBTree *tree);
+
+/**
+ * @brief Get the largest element of the binary tree.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return A pointer to the largest element, or NULL if the tree is empty.
+ */
+void *rbtree_max(const RBTree *tree);
+
+/**
+ * @brief Get the element at a position in sorted order.
+ *
+ * This function returns the k-th smallest element, counting from 0, so a
+ * percentile p of a tree of n elements is rbtree_select(tree, n * p / 100)
+ * (with p < 100). It takes O(log n) with RBTREE_ORDER_STATS and O(k) otherwise.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param k The position of the element in ascending order.
+ * @return A pointer to the element, or NULL if k is not less than the size of the tree.
+ */
+void *rbtree_select(const RBTree *tree, size_t k);
+
+/**
+ * @brief Count the elements less than a key.
+ *
+ * The key does not need to be in the tree; if it is, the result is its
+ * position for rbtree_select. It takes O(log n) with RBTREE_ORDER_STATS and
+ * O(rank) otherwise.
  *
  * @param tree A pointer to the BinaryTree.
- * @param element A pointer to the data of the element to be removed.
+ * @param key A pointer to the key to rank.
+ * @return The number of elements less than key.
  */
-void rbtree_remove(RBTree *tree, void *element);
+size_t rbtree_rank(const RBTree *tree, const void *key);
+
+/**
+ * @brief Count the elements in the range [lo, hi).
+ *
+ * This function counts the elements rbtree_visit_range would visit, as the
+ * difference of two ranks, without visiting them.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param lo The inclusive lower bound of the range.
+ * @param hi The exclusive upper bound of the range.
+ * @return The number of elements not less than lo and less than hi.
+ */
+size_t rbtree_count_range(const RBTree *tree, const void *lo, const void *hi);
+
+/**
+ * @brief Call a function on every element in the range [lo, hi).
+ *
+ * This function finds the first element not less than lo and walks forward in
+ * order until it reaches an element that is not less than hi, so it costs
+ * O(log n + k) for k visited elements. Returning true from visit stops the
+ * traversal.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param lo The inclusive lower bound of the range.
+ * @param hi The exclusive upper bound of the range.
+ * @param visit The function called for each element in the range.
+ * @param context A pointer passed unchanged to visit.
+ * @return true if visit stopped the traversal early, otherwise false.
+ */
+bool rbtree_visit_range(const RBTree *tree, const void *lo, const void *hi,
+    bool (*visit)(void *data, void *context), void *context);
+
+/**
+ * @brief Get the number of elements in the binary tree.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return The number of elements in the tree.
+ */
+size_t rbtree_get_size(const RBTree *tree);
+
+/**
+ * @brief Check if the binary tree is empty.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return true if the tree is empty, otherwise false.
+ */
+bool rbtree_is_empty(const RBTree *tree);
 
 /**
  * @brief Perform an inorder traversal of the binary tree.
  *
  * This function performs an inorder traversal of the binary tree,
- * calling the provided print function on each element.
+ * calling the provided print function on each element. The traversal is
+ * iterative, so it needs no stack space proportional to the tree height.
  *
  * @param tree A pointer to the BinaryTree.
  * @param print A function pointer to a function that prints an individual element.
@@ -79,7 +403,7 @@ void rbtree_inorder(RBTree *tree, void (*print)(void *));
 /**
  * @brief Perform a preorder traversal of the binary tree.
  *
- * This function performs a preorder traversal of the binary tree,
+ * This function performs an iterative preorder traversal of the binary tree,
  * calling the provided print function on each element.
  *
  * @param tree A pointer to the BinaryTree.
@@ -91,7 +415,7 @@ void rbtree_preorder(RBTree *tree, void (*print)(void *));
 /**
  * @brief Perform a postorder traversal of the binary tree.
  *
- * This function performs a postorder traversal of the binary tree,
+ * This function performs an iterative postorder traversal of the binary tree,
  * calling the provided print function on each element.
  *
  * @param tree A pointer to the BinaryTree.
@@ -99,4 +423,153 @@ void rbtree_preorder(RBTree *tree, void (*print)(void *));
  */
 void rbtree_postorder(RBTree *tree, void (*print)(void *));
 
+/**
+ * @brief Call a function on every element in order until it asks to stop.
+ *
+ * Returning true from visit stops the traversal.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param visit The function called for each element.
+ * @param context A pointer passed unchanged to visit.
+ * @return true if visit stopped the traversal early, otherwise false.
+ */
+bool rbtree_visit_inorder(const RBTree *tree, bool (*visit)(void *data, void *context), void *context);
+
+/**
+ * @brief Call a function on every element in preorder until it asks to stop.
+ *
+ * Returning true from visit stops the traversal.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param visit The function called for each element.
+ * @param context A pointer passed unchanged to visit.
+ * @return true if visit stopped the traversal early, otherwise false.
+ */
+bool rbtree_visit_preorder(const RBTree *tree, bool (*visit)(void *data, void *context), void *context);
+
+/**
+ * @brief Call a function on every element in postorder until it asks to stop.
+ *
+ * Returning true from visit stops the traversal.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param visit The function called for each element.
+ * @param context A pointer passed unchanged to visit.
+ * @return true if visit stopped the traversal early, otherwise false.
+ */
+bool rbtree_visit_postorder(const RBTree *tree, bool (*visit)(void *data, void *context), void *context);
+
+/**
+ * @brief Call a function on every element using several threads.
+ *
+ * This function splits the tree into subtrees near the root and hands them
+ * out to up to threads threads, the calling thread included. Elements are
+ * visited in no particular order and visit may run concurrently, so it must
+ * be safe to call from several threads. The tree must not be modified
+ * until the call returns.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param threads The maximum number of threads to use; 0 or 1 runs on the calling thread only.
+ * @param visit The function called for each element.
+ * @param context A pointer passed unchanged to visit.
+ * @return true on success, false if the work could not be allocated.
+ */
+bool rbtree_parallel_visit(const RBTree *tree, size_t threads, void (*visit)(void *data, void *context), void *context);
+
+/**
+ * @brief Reduce every element of the tree using several threads.
+ *
+ * This function splits the tree like rbtree_parallel_visit and gives each
+ * thread one partial result, which accumulates all the subtrees that thread
+ * processes. The partials are then combined into result, which is first set
+ * up by init (or zero-filled) and must hold partial_size bytes. The order in
+ * which elements reach a partial, and partials reach result, is unspecified,
+ * so combine should be associative and commutative.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param threads The maximum number of threads to use; 0 or 1 runs on the calling thread only.
+ * @param reducer The callbacks and partial size of the reduction.
+ * @param result A pointer to partial_size bytes receiving the combined result.
+ * @return true on success, false if the work could not be allocated.
+ */
+bool rbtree_parallel_reduce(const RBTree *tree, size_t threads, const RBTreeReducer *reducer, void *result);
+
+/**
+ * @brief Reduce every element of the tree in order using several threads.
+ *
+ * Like rbtree_parallel_reduce, but each subtree gets its own partial, filled
+ * in ascending order, and the partials are combined into result in ascending
+ * order of their subtrees. combine only needs to be associative, so in-order
+ * consumers such as concatenations or running checks see the elements as a
+ * sequential in-order traversal would. It keeps one partial per subtree
+ * (about 8 per thread) instead of one per thread.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param threads The maximum number of threads to use; 0 or 1 runs on the calling thread only.
+ * @param reducer The callbacks and partial size of the reduction.
+ * @param result A pointer to partial_size bytes receiving the combined result.
+ * @return true on success, false if the work could not be allocated.
+ */
+bool rbtree_parallel_reduce_ordered(const RBTree *tree, size_t threads, const RBTreeReducer *reducer, void *result);
+
+/**
+ * @brief Create an iterator at the smallest element.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return An iterator at the smallest element (or past the end if the tree is empty).
+ */
+RBTreeIter rbtree_iter_begin(const RBTree *tree);
+
+/**
+ * @brief Create an iterator at the largest element.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @return An iterator at the largest element (or past the end if the tree is empty).
+ */
+RBTreeIter rbtree_iter_last(const RBTree *tree);
+
+/**
+ * @brief Create an iterator at the smallest element that is not less than key.
+ *
+ * @param tree A pointer to the BinaryTree.
+ * @param key A pointer to data compared against the elements.
+ * @return An iterator at the element, or past the end if every element is less than key.
+ */
+RBTreeIter rbtree_iter_lower_bound(const RBTree *tree, const void *key);
+
+/**
+ * @brief Check if an iterator is on an element.
+ *
+ * @param iter A pointer to the iterator.
+ * @return true if the iterator is on an element, false once it moved past either end.
+ */
+bool rbtree_iter_valid(const RBTreeIter *iter);
+
+/**
+ * @brief Get the element an iterator is on.
+ *
+ * @param iter A pointer to the iterator.
+ * @return A pointer to the element, or NULL if the iterator is past either end.
+ */
+void *rbtree_iter_get(const RBTreeIter *iter);
+
+/**
+ * @brief Move an iterator to the next larger element.
+ *
+ * Moving past the largest element leaves the iterator past the end.
+ *
+ * @param iter A pointer to the iterator.
+ */
+void rbtree_iter_next(RBTreeIter *iter);
+
+/**
+ * @brief Move an iterator to the next smaller element.
+ *
+ * Moving before the smallest element leaves the iterator past the end;
+ * moving back from past the end lands on the largest element.
+ *
+ * @param iter A pointer to the iterator.
+ */
+void rbtree_iter_prev(RBTreeIter *iter);
+
 #endif //__RBTREE_H__
\ No newline at end of file
@@ -0,0 +1,450 @@
+/**
+ * @file RBTreeT.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RBTREET_H__
+#define __RBTREET_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "RAllocator.h"
+
+/* A red-black tree with n < 2^63 nodes is less than 2 * 63 levels high. */
+#define RBTREET_MAX_HEIGHT 128
+
+/**
+ * @brief Three-way comparison of two pointed-to scalars, for RBTREE_DEFINE.
+ *
+ * Evaluates to -1, 0 or 1 without the overflow of subtracting the values.
+ */
+#define RBTREE_COMPARE_SCALAR(a, b) ((*(a) > *(b)) - (*(a) < *(b)))
+
+/**
+ * @brief Generate a red-black tree specialised for one key type.
+ *
+ * RBTREE_DEFINE(name, prefix, T, compare) defines the struct `name` and a set
+ * of static inline functions named `prefix_*` that store keys of type T by
+ * value in their nodes. compare(a, b) is expanded in place with two
+ * `const T *` arguments and must yield a negative, zero or positive int, like
+ * the comparator of rbtree_init_compare; because it is a macro or an inline
+ * function rather than a function pointer, each step of a descent compiles to
+ * a direct comparison with no indirect call. Balancing follows RBTree, and
+ * like RBTree every allocation goes through the RAllocator stored in the tree.
+ *
+ * Example:
+ * @code
+ * RBTREE_DEFINE(RIntTree, rinttree, int, RBTREE_COMPARE_SCALAR)
+ *
+ * RIntTree *tree = rinttree_init();
+ * rinttree_insert(tree, 42);
+ * bool found = rinttree_contains(tree, 42);
+ * rinttree_destroy(tree);
+ * @endcode
+ *
+ * Generated functions:
+ * - `name *prefix_init(void)` allocates an empty tree, NULL on failure.
+ * - `name *prefix_init_alloc(const RAllocator *allocator)` same, but the tree and
+ *   its nodes come from allocator (NULL for malloc/free).
+ * - `void prefix_destroy(name *tree)` frees the tree and its nodes.
+ * - `bool prefix_insert(name *tree, T key)` inserts a copy of key, false if an equal key is
+ *   already in the tree or the allocation failed.
+ * - `bool prefix_remove(name *tree, T key)` removes the equal key, false if there is none.
+ * - `T *prefix_find(const name *tree, T key)` the stored key equal to key, or NULL.
+ * - `bool prefix_contains(const name *tree, T key)` whether an equal key is stored.
+ * - `T *prefix_lower_bound(const name *tree, T key)` the smallest stored key not less than key, or NULL.
+ * - `T *prefix_min(const name *tree)` and `T *prefix_max(const name *tree)`, NULL if the tree is empty.
+ * - `bool prefix_visit_inorder(const name *tree, bool (*visit)(T *key, void *context), void *context)`
+ *   calls visit on each key in ascending order until it returns true; returns true if it stopped early.
+ * - `size_t prefix_get_size(const name *tree)` and `bool prefix_is_empty(const name *tree)`.
+ *
+ * Returned key pointers stay valid until that key is removed. Stored keys must
+ * not be modified in a way that changes their order. The struct members are
+ * visible so the functions can be inlined, but callers should go through the
+ * generated functions.
+ *
+ * @param name The struct type to define.
+ * @param prefix The prefix of the generated functions.
+ * @param T The key type.
+ * @param compare The three-way comparison, a macro or function taking two const T pointers.
+ */
+#define RBTREE_DEFINE(name, prefix, T, compare)                                                \
+    typedef struct name##Node                                                                  \
+    {                                                                                          \
+        T key;                                                                                 \
+        struct name##Node *left;                                                               \
+        struct name##Node *right;                                                              \
+        struct name##Node *parent;                                                             \
+        bool red;                                                                              \
+    } name##Node;                                                                              \
+                                                                                               \
+    typedef struct name                                                                        \
+    {                                                                                          \
+        name##Node *root;                                                                      \
+        size_t size;                                                                           \
+        RAllocator allocator;                                                                  \
+    } name;                                                                                    \
+                                                                                               \
+    static inline name *prefix##_init_alloc(const RAllocator *allocator)                       \
+    {                                                                                          \
+        if (allocator == NULL)                                                                 \
+            allocator = rallocator_default();                                                  \
+        name *tree = (name *)rallocator_alloc(allocator, sizeof(name));                        \
+        if (tree == NULL)                                                                      \
+            return (NULL);                                                                     \
+        tree->root = NULL;                                                                     \
+        tree->size = 0;                                                                        \
+        tree->allocator = *allocator;                                                          \
+        return (tree);                                                                         \
+    }                                                                                          \
+                                                                                               \
+    static inline name *prefix##_init(void)                                                    \
+    {                                                                                          \
+        return (prefix##_init_alloc(NULL));                                                    \
+    }                                                                                          \
+                                                                                               \
+    static inline void prefix##_destroy(name *tree)                                            \
+    {                                                                                          \
+        if (tree == NULL)                                                                      \
+            return;                                                                            \
+        RAllocator allocator = tree->allocator;                                                \
+        name##Node *node = tree->root;                                                         \
+        while (node != NULL)                                                                   \
+        {                                                                                      \
+            if (node->left != NULL)                                                            \
+                node = node->left;                                                             \
+            else if (node->right != NULL)                                                      \
+                node = node->right;                                                            \
+            else                                                                               \
+            {                                                                                  \
+                name##Node *parent = node->parent;                                             \
+                if (parent != NULL && parent->left == node)                                    \
+                    parent->left = NULL;                                                       \
+                else if (parent != NULL)                                                       \
+                    parent->right = NULL;                                                      \
+                rallocator_free(&allocator, node, sizeof(name##Node));                         \
+                node = parent;                                                                 \
+            }                                                                                  \
+        }                                                                                      \
+        rallocator_free(&allocator, tree, sizeof(name));                                       \
+    }                                                                                          \
+                                                                                               \
+    static inline name##Node *prefix##_min_node(name##Node *node)                              \
+    {                                                                                          \
+        if (node != NULL)                                                                      \
+            while (node->left != NULL)                                                         \
+                node = node->left;                                                             \
+        return (node);                                                                         \
+    }                                                                                          \
+                                                                                               \
+    static inline name##Node *prefix##_max_node(name##Node *node)                              \
+    {                                                                                          \
+        if (node != NULL)                                                                      \
+            while (node->right != NULL)                                                        \
+                node = node->right;                                                            \
+        return (node);                                                                         \
+    }                                                                                          \
+                                                                                               \
+    static inline void prefix##_replace_child(name *tree, name##Node *node, name##Node *child) \
+    {                                                                                          \
+        if (node->parent == NULL)                                                              \
+            tree->root = child;                                                                \
+        else if (node == node->parent->left)                                                   \
+            node->parent->left = child;                                                        \
+        else                                                                                   \
+            node->parent->right = child;                                                       \
+        if (child != NULL)                                                                     \
+            child->parent = node->parent;                                                      \
+    }                                                                                          \
+                                                                                               \
+    static inline void prefix##_rotate_left(name *tree, name##Node *node)                      \
+    {                                                                                          \
+        name##Node *pivot = node->right;                                                       \
+        node->right = pivot->left;                                                             \
+        if (pivot->left != NULL)                                                               \
+            pivot->left->parent = node;                                                        \
+        prefix##_replace_child(tree, node, pivot);                                             \
+        pivot->left = node;                                                                    \
+        node->parent = pivot;                                                                  \
+    }                                                                                          \
+                                                                                               \
+    static inline void prefix##_rotate_right(name *tree, name##Node *node)                     \
+    {                                                                                          \
+        name##Node *pivot = node->left;                                                        \
+        node->left = pivot->right;                                                             \
+        if (pivot->right != NULL)                                                              \
+            pivot->right->parent = node;                                                       \
+        prefix##_replace_child(tree, node, pivot);                                             \
+        pivot->right = node;                                                                   \
+        node->parent = pivot;                                                                  \
+    }                                                                                          \
+                                                                                               \
+    static inline void prefix##_insert_fixup(name *tree, name##Node *node)                     \
+    {                                                                                          \
+        name##Node *parent;                                                                    \
+        while ((parent = node->parent) != NULL && parent->red)                                 \
+        {                                                                                      \
+            name##Node *grandparent = parent->parent;                                          \
+            name##Node *uncle = grandparent->left;                                             \
+            if (parent == grandparent->left)                                                   \
+                uncle = grandparent->right;                                                    \
+            if (uncle != NULL && uncle->red)                                                   \
+            {                                                                                  \
+                parent->red = uncle->red = false;                                              \
+                grandparent->red = true;                                                       \
+                node = grandparent;                                                            \
+                continue;                                                                      \
+            }                                                                                  \
+            if (parent == grandparent->left)                                                   \
+            {                                                                                  \
+                if (node == parent->right)                                                     \
+                {                                                                              \
+                    prefix##_rotate_left(tree, parent);                                        \
+                    parent = node;                                                             \
+                }                                                                              \
+                prefix##_rotate_right(tree, grandparent);                                      \
+            }                                                                                  \
+            else                                                                               \
+            {                                                                                  \
+                if (node == parent->left)                                                      \
+                {                                                                              \
+                    prefix##_rotate_right(tree, parent);                                       \
+                    parent = node;                                                             \
+                }                                                                              \
+                prefix##_rotate_left(tree, grandparent);                                       \
+            }                                                                                  \
+            parent->red = false;                                                               \
+            grandparent->red = true;                                                           \
+            break;                                                                             \
+        }                                                                                      \
+        tree->root->red = false;                                                               \
+    }                                                                                          \
+                                                                                               \
+    static inline bool prefix##_insert(name *tree, T key)                                      \
+    {                                                                                          \
+        name##Node *parent = NULL;                                                             \
+        name##Node **link = &tree->root;                                                       \
+        while (*link != NULL)                                                                  \
+        {                                                                                      \
+            parent = *link;                                                                    \
+            int order = (compare(&key, &parent->key));                                         \
+            if (order < 0)                                                                     \
+                link = &parent->left;                                                          \
+            else if (order > 0)                                                                \
+                link = &parent->right;                                                         \
+            else                                                                               \
+                return (false);                                                                \
+        }                                                                                      \
+        name##Node *node = (name##Node *)rallocator_alloc(&tree->allocator,                    \
+            sizeof(name##Node));                                                               \
+        if (node == NULL)                                                                      \
+            return (false);                                                                    \
+        node->key = key;                                                                       \
+        node->left = node->right = NULL;                                                       \
+        node->parent = parent;                                                                 \
+        node->red = true;                                                                      \
+        *link = node;                                                                          \
+        tree->size++;                                                                          \
+        prefix##_insert_fixup(tree, node);                                                     \
+        return (true);                                                                         \
+    }                                                                                          \
+                                                                                               \
+    static inline name##Node *prefix##_find_node(const name *tree, const T *key)               \
+    {                                                                                          \
+        name##Node *node = tree->root;                                                         \
+        while (node != NULL)                                                                   \
+        {                                                                                      \
+            int order = (compare(key, &node->key));                                            \
+            if (order < 0)                                                                     \
+                node = node->left;                                                             \
+            else if (order > 0)                                                                \
+                node = node->right;                                                            \
+            else                                                                               \
+                return (node);                                                                 \
+        }                                                                                      \
+        return (NULL);                                                                         \
+    }                                                                                          \
+                                                                                               \
+    static inline T *prefix##_find(const name *tree, T key)                                    \
+    {                                                                                          \
+        name##Node *node = prefix##_find_node(tree, &key);                                     \
+        return (node != NULL ? &node->key : NULL);                                             \
+    }                                                                                          \
+                                                                                               \
+    static inline bool prefix##_contains(const name *tree, T key)                              \
+    {                                                                                          \
+        return (prefix##_find_node(tree, &key) != NULL);                                       \
+    }                                                                                          \
+                                                                                               \
+    static inline T *prefix##_lower_bound(const name *tree, T key)                             \
+    {                                                                                          \
+        name##Node *bound = NULL;                                                              \
+        name##Node *node = tree->root;                                                         \
+        while (node != NULL)                                                                   \
+        {                                                                                      \
+            if ((compare(&node->key, &key)) < 0)                                               \
+                node = node->right;                                                            \
+            else                                                                               \
+            {                                                                                  \
+                bound = node;                                                                  \
+                node = node->left;                                                             \
+            }                                                                                  \
+        }                                                                                      \
+        return (bound != NULL ? &bound->key : NULL);                                           \
+    }                                                                                          \
+                                                                                               \
+    static inline void prefix##_remove_fixup(name *tree, name##Node *node, name##Node *parent) \
+    {                                                                                          \
+        while (node != tree->root && (node == NULL || !node->red))                             \
+        {                                                                                      \
+            if (node == parent->left)                                                          \
+            {                                                                                  \
+                name##Node *sibling = parent->right;                                           \
+                if (sibling->red)                                                              \
+                {                                                                              \
+                    sibling->red = false;                                                      \
+                    parent->red = true;                                                        \
+                    prefix##_rotate_left(tree, parent);                                        \
+                    sibling = parent->right;                                                   \
+                }                                                                              \
+                if ((sibling->left == NULL || !sibling->left->red)                             \
+                    && (sibling->right == NULL || !sibling->right->red))                       \
+                {                                                                              \
+                    sibling->red = true;                                                       \
+                    node = parent;                                                             \
+                    parent = node->parent;                                                     \
+                    continue;                                                                  \
+                }                                                                              \
+                if (sibling->right == NULL || !sibling->right->red)                            \
+                {                                                                              \
+                    sibling->left->red = false;                                                \
+                    sibling->red = true;                                                       \
+                    prefix##_rotate_right(tree, sibling);                                      \
+                    sibling = parent->right;                                                   \
+                }                                                                              \
+                sibling->red = parent->red;                                                    \
+                parent->red = false;                                                           \
+                sibling->right->red = false;                                                   \
+                prefix##_rotate_left(tree, parent);                                            \
+            }                                                                                  \
+            else                                                                               \
+            {                                                                                  \
+                name##Node *sibling = parent->left;                                            \
+                if (sibling->red)                                                              \
+                {                                                                              \
+                    sibling->red = false;                                                      \
+                    parent->red = true;                                                        \
+                    prefix##_rotate_right(tree, parent);                                       \
+                    sibling = parent->left;                                                    \
+                }                                                                              \
+                if ((sibling->left == NULL || !sibling->left->red)                             \
+                    && (sibling->right == NULL || !sibling->right->red))                       \
+                {                                                                              \
+                    sibling->red = true;                                                       \
+                    node = parent;                                                             \
+                    parent = node->parent;                                                     \
+                    continue;                                                                  \
+                }                                                                              \
+                if (sibling->left == NULL || !sibling->left->red)                              \
+                {                                                                              \
+                    sibling->right->red = false;                                               \
+                    sibling->red = true;                                                       \
+                    prefix##_rotate_left(tree, sibling);                                       \
+                    sibling = parent->left;                                                    \
+                }                                                                              \
+                sibling->red = parent->red;                                                    \
+                parent->red = false;                                                           \
+                sibling->left->red = false;                                                    \
+                prefix##_rotate_right(tree, parent);                                           \
+            }                                                                                  \
+            node = tree->root;                                                                 \
+        }                                                                                      \
+        if (node != NULL)                                                                      \
+            node->red = false;                                                                 \
+    }                                                                                          \
+                                                                                               \
+    static inline bool prefix##_remove(name *tree, T key)                                      \
+    {                                                                                          \
+        name##Node *node = prefix##_find_node(tree, &key);                                     \
+        name##Node *child;                                                                     \
+        name##Node *parent;                                                                    \
+        bool removed_red;                                                                      \
+        if (node == NULL)                                                                      \
+            return (false);                                                                    \
+        if (node->left == NULL || node->right == NULL)                                         \
+        {                                                                                      \
+            child = node->left != NULL ? node->left : node->right;                             \
+            parent = node->parent;                                                             \
+            removed_red = node->red;                                                           \
+            prefix##_replace_child(tree, node, child);                                         \
+        }                                                                                      \
+        else                                                                                   \
+        {                                                                                      \
+            name##Node *successor = prefix##_min_node(node->right);                            \
+            child = successor->right;                                                          \
+            removed_red = successor->red;                                                      \
+            if (successor->parent == node)                                                     \
+                parent = successor;                                                            \
+            else                                                                               \
+            {                                                                                  \
+                parent = successor->parent;                                                    \
+                prefix##_replace_child(tree, successor, child);                                \
+                successor->right = node->right;                                                \
+                successor->right->parent = successor;                                          \
+            }                                                                                  \
+            prefix##_replace_child(tree, node, successor);                                     \
+            successor->left = node->left;                                                      \
+            successor->left->parent = successor;                                               \
+            successor->red = node->red;                                                        \
+        }                                                                                      \
+        rallocator_free(&tree->allocator, node, sizeof(name##Node));                           \
+        tree->size--;                                                                          \
+        if (!removed_red)                                                                      \
+            prefix##_remove_fixup(tree, child, parent);                                        \
+        return (true);                                                                         \
+    }                                                                                          \
+                                                                                               \
+    static inline T *prefix##_min(const name *tree)                                            \
+    {                                                                                          \
+        name##Node *node = prefix##_min_node(tree->root);                                      \
+        return (node != NULL ? &node->key : NULL);                                             \
+    }                                                                                          \
+                                                                                               \
+    static inline T *prefix##_max(const name *tree)                                            \
+    {                                                                                          \
+        name##Node *node = prefix##_max_node(tree->root);                                      \
+        return (node != NULL ? &node->key : NULL);                                             \
+    }                                                                                          \
+                                                                                               \
+    static inline bool prefix##_visit_inorder(const name *tree,                                \
+        bool (*visit)(T *key, void *context), void *context)                                   \
+    {                                                                                          \
+        name##Node *stack[RBTREET_MAX_HEIGHT];                                                 \
+        size_t depth = 0;                                                                      \
+        name##Node *node = tree->root;                                                         \
+        while (node != NULL || depth > 0)                                                      \
+        {                                                                                      \
+            for (; node != NULL; node = node->left)                                            \
+                stack[depth++] = node;                                                         \
+            node = stack[--depth];                                                             \
+            if (visit(&node->key, context))                                                    \
+                return (true);                                                                 \
+            node = node->right;                                                                \
+        }                                                                                      \
+        return (false);                                                                        \
+    }                                                                                          \
+                                                                                               \
+    static inline size_t prefix##_get_size(const name *tree)                                   \
+    {                                                                                          \
+        return (tree->size);                                                                   \
+    }                                                                                          \
+                                                                                               \
+    static inline bool prefix##_is_empty(const name *tree)                                     \
+    {                                                                                          \
+        return (tree->size == 0);                                                              \
+    }
+
+#endif //__RBTREET_H__
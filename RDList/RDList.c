@@ -0,0 +1,221 @@
+#include "RDList.h"
+#include "RAllocator.h"
+#include "RPool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct RDNode
+{
+    void *data;
+    struct RDNode *prev;
+    struct RDNode *next;
+} RDNode;
+
+typedef struct RDList
+{
+    RDNode *head;
+    RDNode *tail;
+    size_t size;
+    size_t type_size;
+    void (*free_data)(void *);
+    int64_t (*compare)(void *, void *);
+    RAllocator allocator;
+    RPool pool;
+} RDList;
+
+static RDNode *rdnode_create(RDList *list, void *data)
+{
+    RDNode *new_node = (RDNode *)rpool_alloc(&list->pool);
+    if (new_node == NULL)
+        return (NULL);
+    new_node->data = data;
+    new_node->prev = new_node->next = NULL;
+    return (new_node);
+}
+
+RDList *rdlist_init(size_t type_size, int64_t (*compare)(void *, void *), void (*free_data)(void *))
+{
+    return (rdlist_init_alloc(type_size, compare, free_data, NULL));
+}
+
+RDList *rdlist_init_alloc(size_t type_size, int64_t (*compare)(void *, void *),
+    void (*free_data)(void *), const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RDList *list = (RDList *)rallocator_alloc(allocator, sizeof(RDList));
+    if (list == NULL)
+        return (NULL);
+    list->allocator = *allocator;
+    rpool_init(&list->pool, sizeof(RDNode), 0, allocator);
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->type_size = type_size;
+    list->compare = compare;
+    list->free_data = free_data;
+    return (list);
+}
+
+void rdlist_destroy(RDList *list)
+{
+    rdlist_clear(list);
+    RAllocator allocator = list->allocator;
+    rallocator_free(&allocator, list, sizeof(RDList));
+}
+
+void rdlist_clear(RDList *list)
+{
+    if (list->free_data != NULL)
+    {
+        for (RDNode *current = list->head; current != NULL; current = current->next)
+            list->free_data(current->data);
+    }
+    rpool_release(&list->pool);
+    list->head = list->tail = NULL;
+    list->size = 0;
+}
+
+RDNode *rdlist_insert_after(RDList *list, RDNode *node, void *data)
+{
+    RDNode *new_node = rdnode_create(list, data);
+    if (new_node == NULL)
+        return (NULL);
+
+    new_node->prev = node;
+    new_node->next = (node != NULL) ? node->next : list->head;
+    if (new_node->next != NULL)
+        new_node->next->prev = new_node;
+    else
+        list->tail = new_node;
+    if (node != NULL)
+        node->next = new_node;
+    else
+        list->head = new_node;
+
+    list->size++;
+    return (new_node);
+}
+
+RDNode *rdlist_insert_before(RDList *list, RDNode *node, void *data)
+{
+    if (node == NULL)
+        return (rdlist_insert_after(list, list->tail, data));
+    return (rdlist_insert_after(list, node->prev, data));
+}
+
+RDNode *rdlist_insert_front(RDList *list, void *data)
+{
+    return (rdlist_insert_after(list, NULL, data));
+}
+
+RDNode *rdlist_insert_back(RDList *list, void *data)
+{
+    return (rdlist_insert_after(list, list->tail, data));
+}
+
+void rdlist_remove_node(RDList *list, RDNode *node)
+{
+    if (node->prev != NULL)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+    if (node->next != NULL)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+
+    if (list->free_data != NULL)
+        list->free_data(node->data);
+    rpool_free(&list->pool, node);
+    list->size--;
+}
+
+void rdlist_remove_front(RDList *list)
+{
+    rdlist_remove_node(list, list->head);
+}
+
+void rdlist_remove_back(RDList *list)
+{
+    rdlist_remove_node(list, list->tail);
+}
+
+bool rdlist_remove(RDList *list, const void *element)
+{
+    RDNode *node = rdlist_find(list, element);
+    if (node == NULL)
+        return (false);
+    rdlist_remove_node(list, node);
+    return (true);
+}
+
+RDNode *rdlist_find(const RDList *list, const void *element)
+{
+    for (RDNode *current = list->head; current != NULL; current = current->next)
+    {
+        if (memcmp(element, current->data, list->type_size) == 0)
+            return (current);
+    }
+    return (NULL);
+}
+
+RDNode *rdlist_first(const RDList *list)
+{
+    return (list->head);
+}
+
+RDNode *rdlist_last(const RDList *list)
+{
+    return (list->tail);
+}
+
+RDNode *rdlist_next(const RDNode *node)
+{
+    return (node->next);
+}
+
+RDNode *rdlist_prev(const RDNode *node)
+{
+    return (node->prev);
+}
+
+void *rdlist_node_data(const RDNode *node)
+{
+    return (node->data);
+}
+
+void *rdlist_get_head(const RDList *list)
+{
+    return (list->head->data);
+}
+
+void *rdlist_get_tail(const RDList *list)
+{
+    return (list->tail->data);
+}
+
+size_t rdlist_get_size(const RDList *list)
+{
+    return (list->size);
+}
+
+bool rdlist_is_empty(const RDList *list)
+{
+    return (list->head == NULL);
+}
+
+void rdlist_print(const RDList *list, void (*print)(void *))
+{
+    for (RDNode *current = list->head; current != NULL; current = current->next)
+        print(current->data);
+}
+
+void rdlist_print_reverse(const RDList *list, void (*print)(void *))
+{
+    for (RDNode *current = list->tail; current != NULL; current = current->prev)
+        print(current->data);
+}
@@ -0,0 +1,239 @@
+/**
+ * @file RDList.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15 
+ */
+
+#ifndef __RDLIST_H__
+#define __RDLIST_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+struct RDList;
+typedef struct RDList RDList;
+
+/**
+ * @brief Handle to one element of a doubly linked list.
+ *
+ * Handles are returned by the insert functions and stay valid until their
+ * element is removed or the list is cleared or destroyed.
+ */
+struct RDNode;
+typedef struct RDNode RDNode;
+
+/**
+ * @brief Initialize a doubly linked list for storing elements of a specified data type.
+ *
+ * Like RList, the list stores the pointers it is given. Every insert returns a
+ * handle that allows removing that element in constant time.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param compare A pointer to a function for comparing two elements of the desired data type.
+ * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
+ * @return A pointer to the initialized list, or NULL if the allocation failed.
+ */
+RDList *rdlist_init(size_t type_size,
+    int64_t (*compare)(void *, void *),
+    void (*free_data)(void *));
+
+/**
+ * @brief Initialize a doubly linked list that uses a custom allocator.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param compare A pointer to a function for comparing two elements of the desired data type.
+ * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized list, or NULL if the allocation failed.
+ */
+RDList *rdlist_init_alloc(size_t type_size,
+    int64_t (*compare)(void *, void *),
+    void (*free_data)(void *),
+    const RAllocator *allocator);
+
+/**
+ * @brief Destroy the list and deallocate all associated memory.
+ *
+ * @param list A pointer to the list to be destroyed.
+ */
+void rdlist_destroy(RDList *list);
+
+/**
+ * @brief Clear all elements from the list.
+ *
+ * All handles into the list become invalid.
+ *
+ * @param list A pointer to the list.
+ */
+void rdlist_clear(RDList *list);
+
+/**
+ * @brief Insert an element at the end of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be inserted.
+ * @return The handle of the new element, or NULL if a node could not be allocated (the list is unchanged).
+ */
+RDNode *rdlist_insert_back(RDList *list, void *data);
+
+/**
+ * @brief Insert an element at the beginning of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be inserted.
+ * @return The handle of the new element, or NULL if a node could not be allocated (the list is unchanged).
+ */
+RDNode *rdlist_insert_front(RDList *list, void *data);
+
+/**
+ * @brief Insert an element right after another one.
+ *
+ * @param list A pointer to the list.
+ * @param node The handle to insert after, or NULL to insert at the front.
+ * @param data A pointer to the data to be inserted.
+ * @return The handle of the new element, or NULL if a node could not be allocated (the list is unchanged).
+ */
+RDNode *rdlist_insert_after(RDList *list, RDNode *node, void *data);
+
+/**
+ * @brief Insert an element right before another one.
+ *
+ * @param list A pointer to the list.
+ * @param node The handle to insert before, or NULL to insert at the back.
+ * @param data A pointer to the data to be inserted.
+ * @return The handle of the new element, or NULL if a node could not be allocated (the list is unchanged).
+ */
+RDNode *rdlist_insert_before(RDList *list, RDNode *node, void *data);
+
+/**
+ * @brief Remove an element by its handle in constant time.
+ *
+ * @param list A pointer to the list.
+ * @param node The handle of the element to be removed.
+ */
+void rdlist_remove_node(RDList *list, RDNode *node);
+
+/**
+ * @brief Remove the element at the beginning of the list.
+ *
+ * @param list A pointer to the (non-empty) list.
+ */
+void rdlist_remove_front(RDList *list);
+
+/**
+ * @brief Remove the element at the end of the list in constant time.
+ *
+ * @param list A pointer to the (non-empty) list.
+ */
+void rdlist_remove_back(RDList *list);
+
+/**
+ * @brief Remove the first element equal to the given one.
+ *
+ * @param list A pointer to the list.
+ * @param element A pointer to the element to be removed.
+ * @return true if an element was removed, otherwise false.
+ */
+bool rdlist_remove(RDList *list, const void *element);
+
+/**
+ * @brief Find the first element equal to the given one.
+ *
+ * @param list A pointer to the list.
+ * @param element A pointer to the element to look for.
+ * @return The handle of the element, or NULL if it is not in the list.
+ */
+RDNode *rdlist_find(const RDList *list, const void *element);
+
+/**
+ * @brief Get the handle of the first element.
+ *
+ * @param list A pointer to the list.
+ * @return The handle of the first element, or NULL if the list is empty.
+ */
+RDNode *rdlist_first(const RDList *list);
+
+/**
+ * @brief Get the handle of the last element.
+ *
+ * @param list A pointer to the list.
+ * @return The handle of the last element, or NULL if the list is empty.
+ */
+RDNode *rdlist_last(const RDList *list);
+
+/**
+ * @brief Get the handle of the element after the given one.
+ *
+ * @param node A handle into the list.
+ * @return The next handle, or NULL at the end of the list.
+ */
+RDNode *rdlist_next(const RDNode *node);
+
+/**
+ * @brief Get the handle of the element before the given one.
+ *
+ * @param node A handle into the list.
+ * @return The previous handle, or NULL at the beginning of the list.
+ */
+RDNode *rdlist_prev(const RDNode *node);
+
+/**
+ * @brief Get the data stored behind a handle.
+ *
+ * @param node A handle into the list.
+ * @return The data pointer that was inserted.
+ */
+void *rdlist_node_data(const RDNode *node);
+
+/**
+ * @brief Get the first element of the list.
+ *
+ * @param list A pointer to the (non-empty) list.
+ * @return A pointer to the first element of the list.
+ */
+void *rdlist_get_head(const RDList *list);
+
+/**
+ * @brief Get the last element of the list.
+ *
+ * @param list A pointer to the (non-empty) list.
+ * @return A pointer to the last element of the list.
+ */
+void *rdlist_get_tail(const RDList *list);
+
+/**
+ * @brief Get the number of elements in the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of elements in the list.
+ */
+size_t rdlist_get_size(const RDList *list);
+
+/**
+ * @brief Check if the list is empty.
+ *
+ * @param list A pointer to the list.
+ * @return true if the list is empty, otherwise false.
+ */
+bool rdlist_is_empty(const RDList *list);
+
+/**
+ * @brief Print the elements of the list from front to back.
+ *
+ * @param list A pointer to the list.
+ * @param print A function pointer for printing elements of any data type.
+ */
+void rdlist_print(const RDList *list, void (*print)(void *));
+
+/**
+ * @brief Print the elements of the list from back to front.
+ *
+ * @param list A pointer to the list.
+ * @param print A function pointer for printing elements of any data type.
+ */
+void rdlist_print_reverse(const RDList *list, void (*print)(void *));
+
+#endif //__RDLIST_H__
@@ -4,6 +4,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include "RDynArray.h"
+#include "RAllocator.h"
 
 typedef struct RDynArray
 {
@@ -11,47 +12,143 @@ typedef struct RDynArray
     size_t capacity;
     size_t size;
     size_t type_size;
+    RDArrayGrowth growth;
+    RAllocator allocator;
 } RDynArray;
 
+static const RDArrayGrowth rdarray_default_growth = { RDARRAY_GROWTH_FACTOR, 2.0, 0 };
+
 RDynArray *rdarray_init(size_t capacity, size_t type_size)
 {
-    RDynArray *array = (RDynArray *)malloc(sizeof(RDynArray)); //TODO: Check for error
-    array->data = malloc(capacity * type_size); //TODO: Check for error
+    return (rdarray_init_ex(capacity, type_size, NULL));
+}
+
+RDynArray *rdarray_init_ex(size_t capacity, size_t type_size, const RDArrayGrowth *growth)
+{
+    return (rdarray_init_alloc(capacity, type_size, growth, NULL));
+}
+
+RDynArray *rdarray_init_alloc(size_t capacity, size_t type_size,
+    const RDArrayGrowth *growth, const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RDynArray *array = (RDynArray *)rallocator_alloc(allocator, sizeof(RDynArray));
+    if (array == NULL)
+        return (NULL);
+    array->data = rallocator_alloc(allocator, capacity * type_size);
+    /* An allocator may answer a zero-byte request with NULL; only a real request can fail. */
+    if (array->data == NULL && capacity * type_size != 0)
+    {
+        rallocator_free(allocator, array, sizeof(RDynArray));
+        return (NULL);
+    }
     memset(array->data, 0, capacity * type_size);
     array->capacity = capacity;
     array->size = 0;
     array->type_size = type_size;
+    array->growth = (growth != NULL) ? *growth : rdarray_default_growth;
+    array->allocator = *allocator;
     return (array);
 }
 
+static size_t rdarray_next_capacity(const RDynArray *array, size_t min_capacity)
+{
+    size_t capacity = array->capacity;
+
+    if (array->growth.policy == RDARRAY_GROWTH_CHUNK)
+    {
+        size_t chunk = array->growth.chunk > 0 ? array->growth.chunk : 1;
+        capacity += chunk;
+    }
+    else
+    {
+        double factor = array->growth.factor > 1.0 ? array->growth.factor : 2.0;
+        capacity = (size_t)((double)capacity * factor);
+        if (capacity <= array->capacity)
+            capacity = array->capacity + 1;
+    }
+
+    return (capacity < min_capacity ? min_capacity : capacity);
+}
+
+static bool rdarray_set_capacity(RDynArray *array, size_t capacity)
+{
+    void *temp = rallocator_realloc(&array->allocator, array->data,
+        array->capacity * array->type_size, capacity * array->type_size);
+    if (temp == NULL)
+        return (false);
+    array->data = temp;
+    array->capacity = capacity;
+    return (true);
+}
+
 void rdarray_destroy(RDynArray *array)
 {
     if (array != NULL)
     {
-        free(array->data);
-        free(array);
+        RAllocator allocator = array->allocator;
+        rallocator_free(&allocator, array->data, array->capacity * array->type_size);
+        rallocator_free(&allocator, array, sizeof(RDynArray));
     }
 }
 
-void rdarray_push_back(RDynArray *array, void *data)
+bool rdarray_push_back(RDynArray *array, void *data)
+{
+    if (array->size >= array->capacity
+        && !rdarray_set_capacity(array, rdarray_next_capacity(array, array->size + 1)))
+        return (false);
+    memcpy((char *)array->data + array->size * array->type_size, data, array->type_size);
+    array->size++;
+    return (true);
+}
+
+bool rdarray_push_back_n(RDynArray *array, const void *data, size_t count)
+{
+    if (array->size + count > array->capacity
+        && !rdarray_set_capacity(array, rdarray_next_capacity(array, array->size + count)))
+        return (false);
+    memcpy((char *)array->data + array->size * array->type_size, data, count * array->type_size);
+    array->size += count;
+    return (true);
+}
+
+bool rdarray_reserve(RDynArray *array, size_t capacity)
 {
-    if (array->size >= array->capacity)
+    if (capacity <= array->capacity)
+        return (true);
+    return (rdarray_set_capacity(array, capacity));
+}
+
+bool rdarray_resize(RDynArray *array, size_t size)
+{
+    if (size > array->capacity
+        && !rdarray_set_capacity(array, rdarray_next_capacity(array, size)))
+        return (false);
+    if (size > array->size)
     {
-        void *temp = realloc(array->data, array->capacity * 2 * array->type_size);
-        if (temp != NULL)
-        {
-            array->data = temp;
-            array->capacity *= 2;
-        }
+        memset((char *)array->data + array->size * array->type_size, 0,
+            (size - array->size) * array->type_size);
     }
-    memcpy((char *)array->data + array->size * array->type_size, data, array->type_size); //TODO: Check for error
-    array->size++;
+    array->size = size;
+    return (true);
+}
+
+bool rdarray_shrink_to_fit(RDynArray *array)
+{
+    size_t capacity = array->size > 0 ? array->size : 1;
+    if (capacity >= array->capacity)
+        return (true);
+    return (rdarray_set_capacity(array, capacity));
 }
 
 void rdarray_pop_back(RDynArray *array)
 {
-    memset((char *)array->data + array->size * array->type_size, 0, array->type_size);
+    if (array->size == 0)
+        return;
     array->size--;
+    memset((char *)array->data + array->size * array->type_size, 0, array->type_size);
 }
 
 void *rdarray_get(const RDynArray *array, size_t index)
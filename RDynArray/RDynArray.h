@@ -7,11 +7,38 @@
 #ifndef __RDARRAY_H__
 #define __RDARRAY_H__
 
+#include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
 
 struct RDynArray;
 typedef struct RDynArray RDynArray;
 
+/**
+ * @brief How a resizable dynamic array grows when it runs out of capacity.
+ */
+typedef enum RDArrayGrowthPolicy
+{
+    RDARRAY_GROWTH_FACTOR, /**< Multiply the capacity by RDArrayGrowth::factor. */
+    RDARRAY_GROWTH_CHUNK   /**< Add RDArrayGrowth::chunk elements to the capacity. */
+} RDArrayGrowthPolicy;
+
+/**
+ * @brief Growth settings of a resizable dynamic array.
+ *
+ * A factor of 1.0 or less and a chunk of 0 fall back to doubling and one
+ * element respectively. Whatever the policy, a single growth step always
+ * makes room for the elements being added.
+ */
+typedef struct RDArrayGrowth
+{
+    RDArrayGrowthPolicy policy;
+    double factor;
+    size_t chunk;
+} RDArrayGrowth;
+
 /**
  * @brief Initialize a resizable dynamic array.
  * 
@@ -20,10 +47,38 @@ typedef struct RDynArray RDynArray;
  * 
  * @param capacity The initial capacity of the array.
  * @param type_size The size of each element in the array.
- * @return A pointer to the newly initialized RDynArray.
+ * @return A pointer to the newly initialized RDynArray, or NULL if the allocation failed.
  */
 RDynArray *rdarray_init(size_t capacity, size_t type_size);
 
+/**
+ * @brief Initialize a resizable dynamic array with a custom growth policy.
+ * 
+ * Same as rdarray_init, but the array grows according to the given policy
+ * instead of doubling.
+ * 
+ * @param capacity The initial capacity of the array.
+ * @param type_size The size of each element in the array.
+ * @param growth The growth policy, or NULL to double the capacity.
+ * @return A pointer to the newly initialized RDynArray, or NULL if the allocation failed.
+ */
+RDynArray *rdarray_init_ex(size_t capacity, size_t type_size, const RDArrayGrowth *growth);
+
+/**
+ * @brief Initialize a resizable dynamic array that uses a custom allocator.
+ * 
+ * Same as rdarray_init_ex, but the array and its buffer are obtained from the
+ * given allocator instead of malloc.
+ * 
+ * @param capacity The initial capacity of the array.
+ * @param type_size The size of each element in the array.
+ * @param growth The growth policy, or NULL to double the capacity.
+ * @param allocator The allocator to use, or NULL for malloc/realloc/free.
+ * @return A pointer to the newly initialized RDynArray, or NULL if the allocation failed.
+ */
+RDynArray *rdarray_init_alloc(size_t capacity, size_t type_size,
+    const RDArrayGrowth *growth, const RAllocator *allocator);
+
 /**
  * @brief Destroy a resizable dynamic array.
  * 
@@ -41,8 +96,57 @@ void rdarray_destroy(RDynArray *array);
  * 
  * @param array A pointer to the RDynArray.
  * @param data A pointer to the data to be added to the array.
+ * @return true on success, false if the array could not grow.
+ */
+bool rdarray_push_back(RDynArray *array, void *data);
+
+/**
+ * @brief Add several elements to the end of the resizable dynamic array.
+ * 
+ * This function copies count contiguous elements to the end of the array
+ * (RDynArray) with at most one reallocation and a single memcpy.
+ * 
+ * @param array A pointer to the RDynArray.
+ * @param data A pointer to the first of count elements to be added.
+ * @param count The number of elements to add.
+ * @return true on success, false if the array could not grow.
+ */
+bool rdarray_push_back_n(RDynArray *array, const void *data, size_t count);
+
+/**
+ * @brief Make sure the resizable dynamic array can hold a given number of elements.
+ * 
+ * This function grows the capacity of the array (RDynArray) to exactly capacity
+ * elements if it is currently smaller. It never shrinks the array.
+ * 
+ * @param array A pointer to the RDynArray.
+ * @param capacity The minimum capacity required.
+ * @return true on success, false if the array could not grow.
+ */
+bool rdarray_reserve(RDynArray *array, size_t capacity);
+
+/**
+ * @brief Change the number of elements in the resizable dynamic array.
+ * 
+ * This function sets the size of the array (RDynArray). Elements added by
+ * growing are zeroed; shrinking drops elements from the end but keeps the capacity.
+ * 
+ * @param array A pointer to the RDynArray.
+ * @param size The new number of elements.
+ * @return true on success, false if the array could not grow.
+ */
+bool rdarray_resize(RDynArray *array, size_t size);
+
+/**
+ * @brief Release unused capacity of the resizable dynamic array.
+ * 
+ * This function reduces the capacity of the array (RDynArray) to its current
+ * size (at least one element).
+ * 
+ * @param array A pointer to the RDynArray.
+ * @return true on success, false if the reallocation failed (the array is unchanged).
  */
-void rdarray_push_back(RDynArray *array, void *data);
+bool rdarray_shrink_to_fit(RDynArray *array);
 
 /**
  * @brief Remove the last element from the resizable dynamic array.
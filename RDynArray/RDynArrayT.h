@@ -0,0 +1,164 @@
+/**
+ * @file RDynArrayT.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RDARRAYT_H__
+#define __RDARRAYT_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "RAllocator.h"
+
+/**
+ * @brief Generate a dynamic array specialised for one element type.
+ *
+ * RDARRAY_DEFINE(name, prefix, T) defines the struct `name` and a set of
+ * static inline functions named `prefix_*` that work on a `T *` buffer instead
+ * of opaque bytes, so element access compiles to plain loads and stores.
+ * Growth follows RDynArray: the capacity doubles when a push finds it full.
+ * Like the untyped containers, every allocation goes through the RAllocator
+ * stored in the array.
+ *
+ * Example:
+ * @code
+ * RDARRAY_DEFINE(RIntArray, rintarray, int)
+ *
+ * RIntArray *array = rintarray_init(16);
+ * rintarray_push_back(array, 42);
+ * int value = rintarray_get(array, 0);
+ * rintarray_destroy(array);
+ * @endcode
+ *
+ * Generated functions:
+ * - `name *prefix_init(size_t capacity)` allocates an empty array, NULL on failure.
+ * - `name *prefix_init_alloc(size_t capacity, const RAllocator *allocator)` same, but the
+ *   array and its buffer come from allocator (NULL for malloc/free).
+ * - `void prefix_destroy(name *array)` frees the array and its buffer.
+ * - `bool prefix_push_back(name *array, T value)` appends, false if growing failed.
+ * - `T prefix_pop_back(name *array)` removes and returns the last element; the array must not be empty.
+ * - `T prefix_get(const name *array, size_t index)` reads an element; index must be < size.
+ * - `void prefix_set(name *array, size_t index, T value)` overwrites an element; index must be < size.
+ * - `T *prefix_at(const name *array, size_t index)` bounds-checked pointer to an element, NULL if out of range.
+ * - `T *prefix_data(const name *array)` the underlying buffer, valid until the next growth.
+ * - `size_t prefix_get_size(const name *array)`, `size_t prefix_get_capacity(const name *array)`
+ *   and `bool prefix_is_empty(const name *array)`.
+ *
+ * The struct members are visible so the functions can be inlined, but callers
+ * should go through the generated functions.
+ *
+ * @param name The struct type to define.
+ * @param prefix The prefix of the generated functions.
+ * @param T The element type.
+ */
+#define RDARRAY_DEFINE(name, prefix, T)                                                 \
+    typedef struct name                                                                 \
+    {                                                                                   \
+        T *data;                                                                        \
+        size_t capacity;                                                                \
+        size_t size;                                                                    \
+        RAllocator allocator;                                                           \
+    } name;                                                                             \
+                                                                                        \
+    static inline name *prefix##_init_alloc(size_t capacity,                            \
+        const RAllocator *allocator)                                                    \
+    {                                                                                   \
+        if (allocator == NULL)                                                          \
+            allocator = rallocator_default();                                           \
+        name *array = (name *)rallocator_alloc(allocator, sizeof(name));                \
+        if (array == NULL)                                                              \
+            return (NULL);                                                              \
+        if (capacity == 0)                                                              \
+            capacity = 1;                                                               \
+        array->data = (T *)rallocator_alloc(allocator, capacity * sizeof(T));           \
+        if (array->data == NULL)                                                        \
+        {                                                                               \
+            rallocator_free(allocator, array, sizeof(name));                            \
+            return (NULL);                                                              \
+        }                                                                               \
+        array->allocator = *allocator;                                                  \
+        array->capacity = capacity;                                                     \
+        array->size = 0;                                                                \
+        return (array);                                                                 \
+    }                                                                                   \
+                                                                                        \
+    static inline name *prefix##_init(size_t capacity)                                  \
+    {                                                                                   \
+        return (prefix##_init_alloc(capacity, NULL));                                   \
+    }                                                                                   \
+                                                                                        \
+    static inline void prefix##_destroy(name *array)                                    \
+    {                                                                                   \
+        if (array != NULL)                                                              \
+        {                                                                               \
+            RAllocator allocator = array->allocator;                                    \
+            rallocator_free(&allocator, array->data, array->capacity * sizeof(T));      \
+            rallocator_free(&allocator, array, sizeof(name));                           \
+        }                                                                               \
+    }                                                                                   \
+                                                                                        \
+    static inline bool prefix##_grow(name *array)                                       \
+    {                                                                                   \
+        T *temp = (T *)rallocator_realloc(&array->allocator, array->data,               \
+            array->capacity * sizeof(T), array->capacity * 2 * sizeof(T));              \
+        if (temp == NULL)                                                               \
+            return (false);                                                             \
+        array->data = temp;                                                             \
+        array->capacity *= 2;                                                           \
+        return (true);                                                                  \
+    }                                                                                   \
+                                                                                        \
+    static inline bool prefix##_push_back(name *array, T value)                         \
+    {                                                                                   \
+        if (array->size >= array->capacity && !prefix##_grow(array))                    \
+            return (false);                                                             \
+        array->data[array->size++] = value;                                             \
+        return (true);                                                                  \
+    }                                                                                   \
+                                                                                        \
+    static inline T prefix##_pop_back(name *array)                                      \
+    {                                                                                   \
+        return (array->data[--array->size]);                                            \
+    }                                                                                   \
+                                                                                        \
+    static inline T prefix##_get(const name *array, size_t index)                       \
+    {                                                                                   \
+        return (array->data[index]);                                                    \
+    }                                                                                   \
+                                                                                        \
+    static inline void prefix##_set(name *array, size_t index, T value)                 \
+    {                                                                                   \
+        array->data[index] = value;                                                     \
+    }                                                                                   \
+                                                                                        \
+    static inline T *prefix##_at(const name *array, size_t index)                       \
+    {                                                                                   \
+        if (index >= array->size)                                                       \
+            return (NULL);                                                              \
+        return (array->data + index);                                                   \
+    }                                                                                   \
+                                                                                        \
+    static inline T *prefix##_data(const name *array)                                   \
+    {                                                                                   \
+        return (array->data);                                                           \
+    }                                                                                   \
+                                                                                        \
+    static inline size_t prefix##_get_size(const name *array)                           \
+    {                                                                                   \
+        return (array->size);                                                           \
+    }                                                                                   \
+                                                                                        \
+    static inline size_t prefix##_get_capacity(const name *array)                       \
+    {                                                                                   \
+        return (array->capacity);                                                       \
+    }                                                                                   \
+                                                                                        \
+    static inline bool prefix##_is_empty(const name *array)                             \
+    {                                                                                   \
+        return (array->size == 0);                                                      \
+    }
+
+#endif //__RDARRAYT_H__
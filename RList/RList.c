@@ -1,4 +1,6 @@
 #include "RList.h"
+#include "RAllocator.h"
+#include "RPool.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -8,6 +10,7 @@ typedef struct RNode
 {
     void *data;
     struct RNode *next;
+    unsigned char payload[]; /* element bytes when the list stores inline */
 } RNode;
 
 typedef struct RList
@@ -16,14 +19,25 @@ typedef struct RList
     RNode *tail;
     size_t size;
     size_t type_size;
+    bool inline_data;
     void (*free_data)(void *);
     int64_t (*compare)(void *, void *);
+    RAllocator allocator;
+    RPool pool;
 } RList;
 
-static RNode *rnode_create(void *data)
+static RNode *rnode_create(RList *list, void *data)
 {
-    RNode *new_node = (RNode *)malloc(sizeof(RNode)); //TODO: Check error
-    new_node->data = data;
+    RNode *new_node = (RNode *)rpool_alloc(&list->pool);
+    if (new_node == NULL)
+        return (NULL);
+    if (list->inline_data)
+    {
+        memcpy(new_node->payload, data, list->type_size);
+        new_node->data = new_node->payload;
+    }
+    else
+        new_node->data = data;
     new_node->next = NULL;
     return (new_node);
 }
@@ -32,36 +46,60 @@ static void rnode_destroy(RList *list, RNode *node)
 {
     if (list->free_data != NULL)
         list->free_data(node->data);
-    free(node);
+    rpool_free(&list->pool, node);
 }
 
 RList *rlist_init(size_t type_size, int64_t (*compare)(void *, void *), void (*free_data)(void *))
 {
-    RList *list = (RList *)malloc(sizeof(RList)); //TODO: Check error
+    return (rlist_init_alloc(type_size, compare, free_data, NULL));
+}
+
+static RList *rlist_create(size_t type_size, int64_t (*compare)(void *, void *),
+    void (*free_data)(void *), const RAllocator *allocator, bool inline_data)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    size_t node_size = sizeof(RNode) + (inline_data ? type_size : 0);
+    RList *list = (RList *)rallocator_alloc(allocator, sizeof(RList));
+    if (list == NULL)
+        return (NULL);
+    list->allocator = *allocator;
+    rpool_init(&list->pool, node_size, 0, allocator);
     list->head = NULL;
     list->tail = NULL;
     list->size = 0;
     list->type_size = type_size;
+    list->inline_data = inline_data;
     list->compare = compare;
     list->free_data = free_data;
     return (list);
 }
 
+RList *rlist_init_alloc(size_t type_size, int64_t (*compare)(void *, void *),
+    void (*free_data)(void *), const RAllocator *allocator)
+{
+    return (rlist_create(type_size, compare, free_data, allocator, false));
+}
+
+RList *rlist_init_inline(size_t type_size, int64_t (*compare)(void *, void *),
+    void (*free_data)(void *), const RAllocator *allocator)
+{
+    return (rlist_create(type_size, compare, free_data, allocator, true));
+}
+
 void rlist_destroy(RList *list)
 {
-    RNode *current = list->head;
-    while (current != NULL)
-    {
-        RNode *next = current->next;
-        rnode_destroy(list, current);
-        current = next;
-    }
-    free(list);
+    rlist_clear(list);
+    RAllocator allocator = list->allocator;
+    rallocator_free(&allocator, list, sizeof(RList));
 }
 
-void rlist_insert_front(RList *list, void *data)
+bool rlist_insert_front(RList *list, void *data)
 {
-    RNode *new_node = rnode_create(data);
+    RNode *new_node = rnode_create(list, data);
+    if (new_node == NULL)
+        return (false);
     if (list->head == NULL)
     {
         list->head = new_node;
@@ -73,64 +111,69 @@ void rlist_insert_front(RList *list, void *data)
         list->head = new_node;
     }
     list->size++;
+    return (true);
 }
 
-void rlist_insert_at(RList *list, void *data, size_t index)
+bool rlist_insert_at(RList *list, void *data, size_t index)
 {
     if (index >= list->size)
-        return;
+        return (false);
     else if (index == 0)
-        rlist_insert_front(list, data);
+        return (rlist_insert_front(list, data));
     else if (index == list->size - 1)
-        rlist_insert_back(list, data);
-    else
-    {
-        RNode *new_node = rnode_create(data);
-        RNode *prev = NULL;
-        RNode *current = list->head;
+        return (rlist_insert_back(list, data));
 
-        for (size_t i = 0; i < index; i++)
-        {
-            prev = current;
-            current = current->next;
-        }
+    RNode *new_node = rnode_create(list, data);
+    if (new_node == NULL)
+        return (false);
+    RNode *prev = NULL;
+    RNode *current = list->head;
 
-        prev->next = new_node;
-        new_node->next = current;
+    for (size_t i = 0; i < index; i++)
+    {
+        prev = current;
+        current = current->next;
     }
 
+    prev->next = new_node;
+    new_node->next = current;
     list->size++;
+    return (true);
 }
 
-void rlist_insert_sorted(RList *list, void *data)
+bool rlist_insert_sorted(RList *list, void *data)
 {
-    if (list->compare(data, list->head->data) >= 0)
-        rlist_insert_front(list, data);
+    if (list->head == NULL || list->compare(data, list->head->data) >= 0)
+        return (rlist_insert_front(list, data));
     else if (list->compare(list->tail->data, data) >= 0)
-        rlist_insert_back(list, data);
-    else
-    {
-        RNode *new_node = rnode_create(data);
-        RNode *prev = list->head;
-        RNode *current = list->head->next;
+        return (rlist_insert_back(list, data));
 
-        while (current != NULL)
+    RNode *prev = list->head;
+    RNode *current = list->head->next;
+
+    while (current != NULL)
+    {
+        if (list->compare(prev->data, data) >= 0 && list->compare(data, current->data) >= 0)
         {
-            if (list->compare(prev->data, data) >= 0 && list->compare(data, current->data) >= 0)
-            {
-                prev->next = new_node;
-                new_node->next = current;
-                return;
-            }
-            prev = current;
-            current = current->next;
+            RNode *new_node = rnode_create(list, data);
+            if (new_node == NULL)
+                return (false);
+            prev->next = new_node;
+            new_node->next = current;
+            list->size++;
+            return (true);
         }
+        prev = current;
+        current = current->next;
     }
+    return (false);
 }
 
-void rlist_insert_back(RList *list, void *data)
+bool rlist_insert_back(RList *list, void *data)
 {
-    RNode *new_node = rnode_create(data);
+    RNode *new_node = rnode_create(list, data);
+    if (new_node == NULL)
+        return (false);
     if (list->head == NULL)
     {
         list->head = new_node;
@@ -142,6 +185,7 @@ void rlist_insert_back(RList *list, void *data)
         list->tail = new_node;
     }
     list->size++;
+    return (true);
 }
 
 void rlist_remove_front(RList *list)
@@ -154,14 +198,14 @@ void rlist_remove_front(RList *list)
 
 void rlist_clear(RList *list)
 {
-    RNode *current = list->head;
-    while (current != NULL)
+    if (list->free_data != NULL)
     {
-        RNode *next = current->next;
-        rnode_destroy(list, current);
-        current = next;
+        for (RNode *current = list->head; current != NULL; current = current->next)
+            list->free_data(current->data);
     }
+    rpool_release(&list->pool);
     list->head = list->tail = NULL;
+    list->size = 0;
 }
 
 void rlist_remove_back(RList *list)
@@ -301,6 +345,9 @@ int64_t rlist_contains_at(const RList *list, const void *element)
 
 bool rlist_is_sorted(const RList *list)
 {
+    if (list->head == NULL)
+        return (true);
+
     RNode *prev = list->head;
     RNode *current = list->head->next; 
 
@@ -315,6 +362,92 @@ bool rlist_is_sorted(const RList *list)
     return (true);
 }
 
+/* Merge two sorted, NULL-terminated chains; equal elements keep a before b. */
+static RNode *rlist_merge_nodes(const RList *list, RNode *a, RNode *b, RNode **tail)
+{
+    RNode head;
+    RNode *last = &head;
+
+    while (a != NULL && b != NULL)
+    {
+        if (list->compare(a->data, b->data) >= 0)
+        {
+            last->next = a;
+            a = a->next;
+        }
+        else
+        {
+            last->next = b;
+            b = b->next;
+        }
+        last = last->next;
+    }
+    last->next = (a != NULL) ? a : b;
+
+    if (tail != NULL)
+    {
+        while (last->next != NULL)
+            last = last->next;
+        *tail = last;
+    }
+    return (head.next);
+}
+
+void rlist_sort(RList *list)
+{
+    /* runs[i] holds a sorted chain of 2^i nodes (or NULL), like the digits of a binary counter. */
+    RNode *runs[64] = { NULL };
+    RNode *current = list->head;
+
+    while (current != NULL)
+    {
+        RNode *run = current;
+        current = current->next;
+        run->next = NULL;
+
+        size_t i = 0;
+        for (; runs[i] != NULL; i++)
+        {
+            run = rlist_merge_nodes(list, runs[i], run, NULL);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+    }
+
+    RNode *sorted = NULL;
+    for (size_t i = 0; i < 64; i++)
+    {
+        if (runs[i] != NULL)
+            sorted = rlist_merge_nodes(list, runs[i], sorted, NULL);
+    }
+
+    list->head = sorted;
+    list->tail = sorted;
+    while (list->tail != NULL && list->tail->next != NULL)
+        list->tail = list->tail->next;
+}
+
+bool rlist_merge_sorted(RList *list, RList *other)
+{
+    if (list == other || list->type_size != other->type_size
+        || list->inline_data != other->inline_data
+        || !rallocator_equal(&list->allocator, &other->allocator))
+        return (false);
+
+    /* Hand over the node memory first: it is the only step that can refuse. */
+    if (!rpool_merge(&list->pool, &other->pool))
+        return (false);
+
+    RNode *tail = NULL;
+    list->head = rlist_merge_nodes(list, list->head, other->head, &tail);
+    list->tail = tail;
+    list->size += other->size;
+
+    other->head = other->tail = NULL;
+    other->size = 0;
+    return (true);
+}
+
 void rlist_reverse(RList *list)
 {
     RNode *prev = NULL;
@@ -331,6 +464,81 @@ void rlist_reverse(RList *list)
     list->head = prev;
 }
 
+RListCursor rlist_cursor_begin(RList *list)
+{
+    RListCursor cursor;
+    cursor.list = list;
+    cursor.prev = NULL;
+    cursor.current = list->head;
+    return (cursor);
+}
+
+bool rlist_cursor_valid(const RListCursor *cursor)
+{
+    return (cursor->current != NULL);
+}
+
+void rlist_cursor_next(RListCursor *cursor)
+{
+    cursor->prev = cursor->current;
+    cursor->current = cursor->current->next;
+}
+
+void *rlist_cursor_get(const RListCursor *cursor)
+{
+    return (cursor->current != NULL ? cursor->current->data : NULL);
+}
+
+void rlist_cursor_remove(RListCursor *cursor)
+{
+    RList *list = cursor->list;
+    RNode *next = cursor->current->next;
+
+    if (cursor->prev != NULL)
+        cursor->prev->next = next;
+    else
+        list->head = next;
+    if (cursor->current == list->tail)
+        list->tail = cursor->prev;
+
+    rnode_destroy(list, cursor->current);
+    cursor->current = next;
+    list->size--;
+}
+
+bool rlist_cursor_insert_after(RListCursor *cursor, void *data)
+{
+    RList *list = cursor->list;
+
+    if (cursor->current == NULL)
+    {
+        if (!rlist_insert_back(list, data))
+            return (false);
+        cursor->current = list->tail;
+        return (true);
+    }
+
+    RNode *new_node = rnode_create(list, data);
+    if (new_node == NULL)
+        return (false);
+    new_node->next = cursor->current->next;
+    cursor->current->next = new_node;
+    if (cursor->current == list->tail)
+        list->tail = new_node;
+    list->size++;
+    return (true);
+}
+
+bool rlist_visit(const RList *list, bool (*visit)(void *data, void *context), void *context)
+{
+    for (RNode *current = list->head; current != NULL; current = current->next)
+    {
+        if (visit(current->data, context))
+            return (true);
+    }
+    return (false);
+}
+
 void rlist_print(const RList *list, void (*print)(void*))
 {
     RNode *current = list->head;
@@ -7,12 +7,32 @@
 #ifndef __RLIST_H__
 #define __RLIST_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "RAllocator.h"
+
 struct RList;
 typedef struct RList RList;
 
+struct RNode;
+
+/**
+ * @brief Position inside a list for single-pass traversal and editing.
+ *
+ * A cursor is a small value created by rlist_cursor_begin and advanced with
+ * rlist_cursor_next. The members are private; they are only visible so the
+ * cursor can live on the stack. Modifying the list other than through the
+ * cursor invalidates it.
+ */
+typedef struct RListCursor
+{
+    RList *list;
+    struct RNode *prev;
+    struct RNode *current;
+} RListCursor;
+
 /**
  * @brief Initialize a list for storing elements of a specified data type.
  *
@@ -23,16 +43,56 @@ typedef struct RList RList;
  * @param type_size The size (in bytes) of the data type.
  * @param compare A pointer to a function for comparing two elements of the desired data type.
  * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
- * @return A pointer to the initialized list.
+ * @return A pointer to the initialized list, or NULL if the allocation failed.
  */
 RList *rlist_init(size_t type_size, 
     int64_t (*compare)(void *, void *),
     void (*free_data)(void *));
 
+/**
+ * @brief Initialize a list that uses a custom allocator.
+ *
+ * Same as rlist_init, but the list and its nodes are obtained from the given
+ * allocator instead of malloc.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param compare A pointer to a function for comparing two elements of the desired data type.
+ * @param free_data A pointer to a function for freeing allocated data, or NULL if not needed.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized list, or NULL if the allocation failed.
+ */
+RList *rlist_init_alloc(size_t type_size,
+    int64_t (*compare)(void *, void *),
+    void (*free_data)(void *),
+    const RAllocator *allocator);
+
+/**
+ * @brief Initialize a list that stores its elements inside the nodes.
+ *
+ * A list created this way copies type_size bytes from the data pointer passed
+ * to the insert functions into the node itself, so every element costs one
+ * allocation and traversals touch one cache line per element. Functions that
+ * return elements (rlist_get_head, rlist_get_element, ...) return pointers into
+ * the node, valid until that element is removed. free_data, if given, is called
+ * with such a pointer and must not free it.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param compare A pointer to a function for comparing two elements of the desired data type.
+ * @param free_data A pointer to a function releasing resources owned by an element, or NULL.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized list, or NULL if the allocation failed.
+ */
+RList *rlist_init_inline(size_t type_size,
+    int64_t (*compare)(void *, void *),
+    void (*free_data)(void *),
+    const RAllocator *allocator);
+
 /**
  * @brief Destroy the list and deallocate all associated memory.
  *
  * This function destroys the list and deallocates all memory associated with it.
+ * Nodes come from slabs owned by the list, so this releases the slabs instead of
+ * freeing every node; the list is only walked when it has a free_data function.
  *
  * @param list A pointer to the list to be destroyed.
  */
@@ -45,8 +105,9 @@ void rlist_destroy(RList *list);
  *
  * @param list A pointer to the list.
  * @param data A pointer to the data to be inserted.
+ * @return true on success, false if a node could not be allocated (the list is unchanged).
  */
-void rlist_insert_back(RList *list, void *data);
+bool rlist_insert_back(RList *list, void *data);
 
 /**
  * @brief Insert an element at the beginning of the list.
@@ -55,8 +116,9 @@ void rlist_insert_back(RList *list, void *data);
  *
  * @param list A pointer to the list.
  * @param data A pointer to the data to be inserted.
+ * @return true on success, false if a node could not be allocated (the list is unchanged).
  */
-void rlist_insert_front(RList *list, void *data);
+bool rlist_insert_front(RList *list, void *data);
 
 /**
  * @brief Insert an element at the specified index.
@@ -66,8 +128,10 @@ void rlist_insert_front(RList *list, void *data);
  * @param list A pointer to the list.
  * @param data A pointer to the data to be inserted.
  * @param index The position at which to insert the element.
+ * @return true on success, false if index is out of range or a node could not be
+ *         allocated (the list is unchanged).
  */
-void rlist_insert_at(RList *list, void *data, size_t index);
+bool rlist_insert_at(RList *list, void *data, size_t index);
 
 /**
  * @brief Insert an element into the list in a sorted order.
@@ -77,13 +141,15 @@ void rlist_insert_at(RList *list, void *data, size_t index);
  *
  * @param list A pointer to the list.
  * @param data A pointer to the data to be inserted.
+ * @return true on success, false if a node could not be allocated (the list is unchanged).
  */
-void rlist_insert_sorted(RList *list, void *data);
+bool rlist_insert_sorted(RList *list, void *data);
 
 /**
  * @brief Clear all elements from the list.
  *
- * This function removes all elements from the list.
+ * This function removes all elements from the list and returns the node slabs
+ * to the allocator.
  *
  * @param list A pointer to the list.
  */
@@ -130,6 +196,34 @@ void rlist_remove(RList *list, void *element);
  */
 void rlist_remove_at(RList *list, size_t index);
 
+/**
+ * @brief Sort the list.
+ *
+ * This function sorts the list in place with a bottom-up merge sort, using the
+ * comparison function provided during initialization. It runs in O(n log n),
+ * allocates nothing and is stable.
+ *
+ * @param list A pointer to the list.
+ */
+void rlist_sort(RList *list);
+
+/**
+ * @brief Merge a sorted list into another sorted list.
+ *
+ * This function moves every element of other into list without allocating;
+ * equal elements of list come first. It costs O(n + m) comparisons and
+ * relinks, plus O(free nodes + slabs) of other's node pool, whose memory is
+ * handed over to list. Afterwards other is empty and can still be used or
+ * destroyed.
+ *
+ * @param list A pointer to the sorted list receiving the elements.
+ * @param other A pointer to the sorted list to merge in.
+ * @return true on success, false (leaving both lists unchanged) if the lists
+ * are the same, store different types or storage modes, or use different
+ * allocators.
+ */
+bool rlist_merge_sorted(RList *list, RList *other);
+
 /**
  * @brief Reverse the order of elements in the list.
  *
@@ -233,6 +327,73 @@ int64_t rlist_contains_at(const RList *list, const void *element);
  */
 bool rlist_is_sorted(const RList *list);
 
+/**
+ * @brief Get a cursor positioned at the first element of the list.
+ *
+ * @param list A pointer to the list.
+ * @return A cursor at the first element (or at the end if the list is empty).
+ */
+RListCursor rlist_cursor_begin(RList *list);
+
+/**
+ * @brief Check if a cursor points at an element.
+ *
+ * @param cursor A pointer to the cursor.
+ * @return true if the cursor is on an element, false once it moved past the end.
+ */
+bool rlist_cursor_valid(const RListCursor *cursor);
+
+/**
+ * @brief Move a cursor to the next element.
+ *
+ * @param cursor A pointer to a valid cursor.
+ */
+void rlist_cursor_next(RListCursor *cursor);
+
+/**
+ * @brief Get the element a cursor points at.
+ *
+ * @param cursor A pointer to the cursor.
+ * @return A pointer to the element, or NULL if the cursor is past the end.
+ */
+void *rlist_cursor_get(const RListCursor *cursor);
+
+/**
+ * @brief Remove the element a cursor points at.
+ *
+ * This function removes the current element in constant time and moves the
+ * cursor to the element that followed it.
+ *
+ * @param cursor A pointer to a valid cursor.
+ */
+void rlist_cursor_remove(RListCursor *cursor);
+
+/**
+ * @brief Insert an element after the one a cursor points at.
+ *
+ * This function inserts in constant time; the cursor stays where it is, so
+ * the new element is the next one visited. A cursor past the end appends and
+ * then points at the new element.
+ *
+ * @param cursor A pointer to the cursor.
+ * @param data A pointer to the data to be inserted.
+ * @return true on success, false if a node could not be allocated (the list is unchanged).
+ */
+bool rlist_cursor_insert_after(RListCursor *cursor, void *data);
+
+/**
+ * @brief Call a function on every element until it asks to stop.
+ *
+ * This function visits the elements from front to back, passing each one with
+ * the caller's context. Returning true from visit stops the traversal.
+ *
+ * @param list A pointer to the list.
+ * @param visit The function called for each element.
+ * @param context A pointer passed unchanged to visit.
+ * @return true if visit stopped the traversal early, otherwise false.
+ */
+bool rlist_visit(const RList *list, bool (*visit)(void *data, void *context), void *context);
+
 /**
  * @brief Print the elements of the list for debugging purposes.
  *
@@ -0,0 +1,196 @@
+#include "RLockFreeStack.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* Chunk k holds RLFSTACK_FIRST_CHUNK << k nodes, so the chunks double in size. */
+#define RLFSTACK_FIRST_CHUNK_SHIFT 6
+#define RLFSTACK_FIRST_CHUNK ((uint64_t)1 << RLFSTACK_FIRST_CHUNK_SHIFT)
+#define RLFSTACK_MAX_CHUNKS (33 - RLFSTACK_FIRST_CHUNK_SHIFT)
+#define RLFSTACK_NIL UINT32_MAX
+
+/* A list head packs a node index (low 32 bits) with a version tag (high 32 bits). */
+#define RLFSTACK_INDEX(head) ((uint32_t)(head))
+#define RLFSTACK_TAG(head) ((uint32_t)((head) >> 32))
+#define RLFSTACK_HEAD(index, tag) (((uint64_t)(tag) << 32) | (uint64_t)(index))
+
+typedef struct RLFNode
+{
+    void *data;
+    _Atomic uint32_t next;
+} RLFNode;
+
+typedef struct RLockFreeStack
+{
+    _Atomic uint64_t top;
+    _Atomic uint64_t free_list;
+    _Atomic uint32_t next_index;
+    atomic_size_t size;
+    _Atomic(RLFNode *) chunks[RLFSTACK_MAX_CHUNKS];
+    RAllocator allocator;
+} RLockFreeStack;
+
+/* Chunk holding the node whose index + RLFSTACK_FIRST_CHUNK is biased. */
+static inline uint32_t rlfstack_chunk_of(uint64_t biased)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return ((uint32_t)(63 - __builtin_clzll(biased)) - RLFSTACK_FIRST_CHUNK_SHIFT);
+#else
+    uint32_t chunk = 0;
+    while (biased >= (RLFSTACK_FIRST_CHUNK << (chunk + 1)))
+        chunk++;
+    return (chunk);
+#endif
+}
+
+static inline RLFNode *rlfstack_node(RLockFreeStack *stack, uint32_t index)
+{
+    uint64_t biased = (uint64_t)index + RLFSTACK_FIRST_CHUNK;
+    uint32_t chunk = rlfstack_chunk_of(biased);
+    RLFNode *nodes = atomic_load_explicit(&stack->chunks[chunk], memory_order_acquire);
+    return (nodes + (biased - (RLFSTACK_FIRST_CHUNK << chunk)));
+}
+
+/* Push node index onto one of the two tagged lists. */
+static void rlfstack_list_push(RLockFreeStack *stack, _Atomic uint64_t *list, uint32_t index)
+{
+    RLFNode *node = rlfstack_node(stack, index);
+    uint64_t head = atomic_load_explicit(list, memory_order_relaxed);
+    uint64_t desired;
+    do
+    {
+        atomic_store_explicit(&node->next, RLFSTACK_INDEX(head), memory_order_relaxed);
+        desired = RLFSTACK_HEAD(index, RLFSTACK_TAG(head) + 1);
+    } while (!atomic_compare_exchange_weak_explicit(list, &head, desired,
+        memory_order_release, memory_order_relaxed));
+}
+
+/* Pop a node index from one of the two tagged lists, RLFSTACK_NIL if it is empty. */
+static uint32_t rlfstack_list_pop(RLockFreeStack *stack, _Atomic uint64_t *list)
+{
+    uint64_t head = atomic_load_explicit(list, memory_order_acquire);
+    for (;;)
+    {
+        uint32_t index = RLFSTACK_INDEX(head);
+        if (index == RLFSTACK_NIL)
+            return (RLFSTACK_NIL);
+
+        /* The node may be popped and reused meanwhile; the tag makes the CAS fail then. */
+        uint32_t next = atomic_load_explicit(&rlfstack_node(stack, index)->next, memory_order_relaxed);
+        uint64_t desired = RLFSTACK_HEAD(next, RLFSTACK_TAG(head) + 1);
+        if (atomic_compare_exchange_weak_explicit(list, &head, desired,
+                memory_order_acquire, memory_order_acquire))
+            return (index);
+    }
+}
+
+/* Take a recycled node, or claim a fresh index and make sure its chunk exists. */
+static uint32_t rlfstack_acquire_node(RLockFreeStack *stack)
+{
+    uint32_t index = rlfstack_list_pop(stack, &stack->free_list);
+    if (index != RLFSTACK_NIL)
+        return (index);
+
+    /* next_index stops at RLFSTACK_NIL; wrapping would hand out live indices again. */
+    index = atomic_load_explicit(&stack->next_index, memory_order_relaxed);
+    do
+    {
+        if (index == RLFSTACK_NIL)
+            return (RLFSTACK_NIL);
+    } while (!atomic_compare_exchange_weak_explicit(&stack->next_index, &index, index + 1,
+        memory_order_relaxed, memory_order_relaxed));
+
+    uint32_t chunk = rlfstack_chunk_of((uint64_t)index + RLFSTACK_FIRST_CHUNK);
+    if (atomic_load_explicit(&stack->chunks[chunk], memory_order_acquire) == NULL)
+    {
+        size_t bytes = (size_t)(RLFSTACK_FIRST_CHUNK << chunk) * sizeof(RLFNode);
+        RLFNode *nodes = (RLFNode *)rallocator_alloc(&stack->allocator, bytes);
+        if (nodes == NULL)
+            return (RLFSTACK_NIL); /* The claimed index is leaked; later pushes retry the chunk. */
+
+        RLFNode *expected = NULL;
+        if (!atomic_compare_exchange_strong_explicit(&stack->chunks[chunk], &expected, nodes,
+                memory_order_acq_rel, memory_order_acquire))
+            rallocator_free(&stack->allocator, nodes, bytes); /* Another thread installed it first. */
+    }
+    return (index);
+}
+
+RLockFreeStack *rlfstack_init(void)
+{
+    return (rlfstack_init_alloc(NULL));
+}
+
+RLockFreeStack *rlfstack_init_alloc(const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RLockFreeStack *stack = (RLockFreeStack *)rallocator_alloc(allocator, sizeof(RLockFreeStack));
+    if (stack == NULL)
+        return (NULL);
+    atomic_init(&stack->top, RLFSTACK_HEAD(RLFSTACK_NIL, 0));
+    atomic_init(&stack->free_list, RLFSTACK_HEAD(RLFSTACK_NIL, 0));
+    atomic_init(&stack->next_index, 0);
+    atomic_init(&stack->size, 0);
+    for (size_t i = 0; i < RLFSTACK_MAX_CHUNKS; i++)
+        atomic_init(&stack->chunks[i], NULL);
+    stack->allocator = *allocator;
+    return (stack);
+}
+
+void rlfstack_destroy(RLockFreeStack *stack)
+{
+    RAllocator allocator = stack->allocator;
+    for (size_t i = 0; i < RLFSTACK_MAX_CHUNKS; i++)
+    {
+        RLFNode *nodes = atomic_load_explicit(&stack->chunks[i], memory_order_relaxed);
+        if (nodes != NULL)
+            rallocator_free(&allocator, nodes, (size_t)(RLFSTACK_FIRST_CHUNK << i) * sizeof(RLFNode));
+    }
+    rallocator_free(&allocator, stack, sizeof(RLockFreeStack));
+}
+
+bool rlfstack_push(RLockFreeStack *stack, void *data)
+{
+    uint32_t index = rlfstack_acquire_node(stack);
+    if (index == RLFSTACK_NIL)
+        return (false);
+
+    rlfstack_node(stack, index)->data = data;
+    rlfstack_list_push(stack, &stack->top, index);
+    atomic_fetch_add_explicit(&stack->size, 1, memory_order_relaxed);
+    return (true);
+}
+
+void *rlfstack_pop(RLockFreeStack *stack)
+{
+    void *data = NULL;
+    rlfstack_try_pop(stack, &data);
+    return (data);
+}
+
+bool rlfstack_try_pop(RLockFreeStack *stack, void **out)
+{
+    uint32_t index = rlfstack_list_pop(stack, &stack->top);
+    if (index == RLFSTACK_NIL)
+        return (false);
+
+    *out = rlfstack_node(stack, index)->data;
+    atomic_fetch_sub_explicit(&stack->size, 1, memory_order_relaxed);
+    rlfstack_list_push(stack, &stack->free_list, index);
+    return (true);
+}
+
+size_t rlfstack_get_size(const RLockFreeStack *stack)
+{
+    size_t size = atomic_load_explicit(&((RLockFreeStack *)stack)->size, memory_order_relaxed);
+    return ((ptrdiff_t)size < 0 ? 0 : size);
+}
+
+bool rlfstack_is_empty(const RLockFreeStack *stack)
+{
+    uint64_t top = atomic_load_explicit(&((RLockFreeStack *)stack)->top, memory_order_acquire);
+    return (RLFSTACK_INDEX(top) == RLFSTACK_NIL);
+}
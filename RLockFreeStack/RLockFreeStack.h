@@ -0,0 +1,107 @@
+/**
+ * @file RLockFreeStack.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+#ifndef __RLOCKFREESTACK_H__
+#define __RLOCKFREESTACK_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+/**
+ * @struct RLockFreeStack
+ * @brief Lock-free stack that any number of threads may push to and pop from.
+ * 
+ * Like RStack it stores pointers to the caller's elements and never copies
+ * or frees them. Nodes live in chunks that are only released by
+ * rlfstack_destroy, so a thread that is still reading a node another thread
+ * just popped never touches freed memory. Popped nodes are recycled through
+ * an internal free list, and the top of the stack is a node index packed
+ * with a version tag that changes on every update, so a compare-and-swap
+ * cannot succeed against a node that was popped and pushed again in between
+ * (the ABA problem).
+ */
+struct RLockFreeStack;
+
+typedef struct RLockFreeStack RLockFreeStack; /** Typedef for RLockFreeStack structure. */
+
+/**
+ * @brief Initialize a lock-free stack.
+ * 
+ * @return A pointer to the newly initialized RLockFreeStack, or NULL if the allocation failed.
+ */
+RLockFreeStack *rlfstack_init(void);
+
+/**
+ * @brief Initialize a lock-free stack that uses a custom allocator.
+ * 
+ * The allocator is called from whichever thread needs a new node chunk, so it
+ * must be thread-safe.
+ * 
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the newly initialized RLockFreeStack, or NULL if the allocation failed.
+ */
+RLockFreeStack *rlfstack_init_alloc(const RAllocator *allocator);
+
+/**
+ * @brief Destroy a lock-free stack.
+ * 
+ * No thread may use the stack any more. The elements are not freed.
+ * 
+ * @param stack A pointer to the RLockFreeStack to be destroyed.
+ */
+void rlfstack_destroy(RLockFreeStack *stack);
+
+/**
+ * @brief Push an element onto the top of the stack.
+ * 
+ * @param stack A pointer to the RLockFreeStack.
+ * @param data A pointer to the element to be pushed.
+ * @return true if the element was pushed, false if no node could be allocated or all
+ *         UINT32_MAX node indices have been handed out.
+ */
+bool rlfstack_push(RLockFreeStack *stack, void *data);
+
+/**
+ * @brief Pop the top element from the stack.
+ * 
+ * @param stack A pointer to the RLockFreeStack.
+ * @return A pointer to the popped element, or NULL if the stack is empty.
+ */
+void *rlfstack_pop(RLockFreeStack *stack);
+
+/**
+ * @brief Pop the top element from the stack if there is one.
+ * 
+ * Unlike rlfstack_pop this tells an empty stack apart from a NULL element.
+ * 
+ * @param stack A pointer to the RLockFreeStack.
+ * @param out Receives the popped element.
+ * @return true if an element was popped, false if the stack was empty.
+ */
+bool rlfstack_try_pop(RLockFreeStack *stack, void **out);
+
+/**
+ * @brief Get the number of elements on the stack.
+ * 
+ * The value is exact only when no other thread is using the stack.
+ * 
+ * @param stack A pointer to the RLockFreeStack.
+ * @return The number of elements on the stack.
+ */
+size_t rlfstack_get_size(const RLockFreeStack *stack);
+
+/**
+ * @brief Check if the stack is empty.
+ * 
+ * The answer is exact only when no other thread is using the stack.
+ * 
+ * @param stack A pointer to the RLockFreeStack.
+ * @return true if the stack is empty, false otherwise.
+ */
+bool rlfstack_is_empty(const RLockFreeStack *stack);
+
+#endif //__RLOCKFREESTACK_H__
@@ -0,0 +1,159 @@
+#include "RMpmcQueue.h"
+#include "RCopy.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+
+#define RMPMC_CACHE_LINE 64
+
+/* A slot is its sequence number followed by type_size bytes of element. */
+typedef struct RMpmcSlot
+{
+    atomic_size_t sequence;
+    unsigned char data[];
+} RMpmcSlot;
+
+typedef struct RMpmcQueue
+{
+    alignas(RMPMC_CACHE_LINE) atomic_size_t enqueue_pos;
+    alignas(RMPMC_CACHE_LINE) atomic_size_t dequeue_pos;
+
+    /* Read-only after initialization. */
+    alignas(RMPMC_CACHE_LINE) unsigned char *slots;
+    size_t capacity;
+    size_t mask;
+    size_t type_size;
+    size_t slot_size;
+    void *block;
+    size_t block_size;
+    RAllocator allocator;
+} RMpmcQueue;
+
+#define RMPMC_SLOT(queue, i) ((RMpmcSlot *)((queue)->slots + ((i) & (queue)->mask) * (queue)->slot_size))
+
+RMpmcQueue *rmpmc_init(size_t capacity, size_t type_size)
+{
+    return (rmpmc_init_alloc(capacity, type_size, NULL));
+}
+
+RMpmcQueue *rmpmc_init_alloc(size_t capacity, size_t type_size, const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    size_t block_size = sizeof(RMpmcQueue) + RMPMC_CACHE_LINE - 1;
+    void *block = rallocator_alloc(allocator, block_size);
+    if (block == NULL)
+        return (NULL);
+    uintptr_t aligned = ((uintptr_t)block + RMPMC_CACHE_LINE - 1) & ~(uintptr_t)(RMPMC_CACHE_LINE - 1);
+    RMpmcQueue *queue = (RMpmcQueue *)aligned;
+
+    size_t slot_align = alignof(RMpmcSlot);
+    queue->slot_size = (sizeof(RMpmcSlot) + type_size + slot_align - 1) & ~(slot_align - 1);
+    queue->capacity = rounded;
+    queue->mask = rounded - 1;
+    queue->type_size = type_size;
+    queue->block = block;
+    queue->block_size = block_size;
+    queue->allocator = *allocator;
+    queue->slots = (unsigned char *)rallocator_alloc(allocator, rounded * queue->slot_size);
+    if (queue->slots == NULL)
+    {
+        rallocator_free(allocator, block, block_size);
+        return (NULL);
+    }
+
+    /* Slot i starts out free for the producer that claims position i. */
+    for (size_t i = 0; i < rounded; i++)
+        atomic_init(&RMPMC_SLOT(queue, i)->sequence, i);
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+    return (queue);
+}
+
+void rmpmc_destroy(RMpmcQueue *queue)
+{
+    RAllocator allocator = queue->allocator;
+    rallocator_free(&allocator, queue->slots, queue->capacity * queue->slot_size);
+    rallocator_free(&allocator, queue->block, queue->block_size);
+}
+
+bool rmpmc_enqueue(RMpmcQueue *queue, const void *data)
+{
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    RMpmcSlot *slot;
+
+    for (;;)
+    {
+        slot = RMPMC_SLOT(queue, pos);
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return (false); /* The slot still holds the element from the previous lap. */
+        else
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    }
+
+    rcopy_element(slot->data, data, queue->type_size);
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+    return (true);
+}
+
+bool rmpmc_dequeue(RMpmcQueue *queue, void *out)
+{
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    RMpmcSlot *slot;
+
+    for (;;)
+    {
+        slot = RMPMC_SLOT(queue, pos);
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return (false); /* Not filled yet for this lap. */
+        else
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    }
+
+    rcopy_element(out, slot->data, queue->type_size);
+    /* Hand the slot to the producer one lap ahead. */
+    atomic_store_explicit(&slot->sequence, pos + queue->mask + 1, memory_order_release);
+    return (true);
+}
+
+size_t rmpmc_get_size(const RMpmcQueue *queue)
+{
+    RMpmcQueue *q = (RMpmcQueue *)queue;
+    size_t dequeued = atomic_load_explicit(&q->dequeue_pos, memory_order_acquire);
+    size_t enqueued = atomic_load_explicit(&q->enqueue_pos, memory_order_acquire);
+    return (enqueued > dequeued ? enqueued - dequeued : 0);
+}
+
+bool rmpmc_is_empty(const RMpmcQueue *queue)
+{
+    return (rmpmc_get_size(queue) == 0);
+}
+
+size_t rmpmc_get_capacity(const RMpmcQueue *queue)
+{
+    return (queue->capacity);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file RMpmcQueue.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+#ifndef __RMPMCQUEUE_H__
+#define __RMPMCQUEUE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+/**
+ * @struct RMpmcQueue
+ * @brief Bounded lock-free queue for any number of producer and consumer threads.
+ * 
+ * Elements are copied into a power-of-two ring of slots. Every slot carries a
+ * sequence number that tells producers whether the slot is free for the lap
+ * they are on and tells consumers whether it has been filled, so a producer
+ * and a consumer only contend on the shared position they claim with one
+ * compare-and-swap, never on a lock. Elements enqueued by one producer are
+ * dequeued in the order that producer enqueued them.
+ */
+struct RMpmcQueue;
+
+typedef struct RMpmcQueue RMpmcQueue; /** Typedef for RMpmcQueue structure. */
+
+/**
+ * @brief Initialize a multi-producer/multi-consumer queue.
+ * 
+ * @param capacity The number of elements the queue holds, rounded up to a power of two.
+ * @param type_size The size of each element in the queue.
+ * @return A pointer to the newly initialized RMpmcQueue, or NULL if the allocation failed.
+ */
+RMpmcQueue *rmpmc_init(size_t capacity, size_t type_size);
+
+/**
+ * @brief Initialize a multi-producer/multi-consumer queue that uses a custom allocator.
+ * 
+ * @param capacity The number of elements the queue holds, rounded up to a power of two.
+ * @param type_size The size of each element in the queue.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the newly initialized RMpmcQueue, or NULL if the allocation failed.
+ */
+RMpmcQueue *rmpmc_init_alloc(size_t capacity, size_t type_size, const RAllocator *allocator);
+
+/**
+ * @brief Destroy a multi-producer/multi-consumer queue.
+ * 
+ * No thread may use the queue any more.
+ * 
+ * @param queue A pointer to the RMpmcQueue to be destroyed.
+ */
+void rmpmc_destroy(RMpmcQueue *queue);
+
+/**
+ * @brief Copy an element to the back of the queue if there is room.
+ * 
+ * @param queue A pointer to the RMpmcQueue.
+ * @param data A pointer to the type_size bytes to be added.
+ * @return true if the element was added, false if the queue was full.
+ */
+bool rmpmc_enqueue(RMpmcQueue *queue, const void *data);
+
+/**
+ * @brief Remove the front element of the queue if there is one.
+ * 
+ * @param queue A pointer to the RMpmcQueue.
+ * @param out Receives a copy of the removed element.
+ * @return true if an element was removed, false if the queue was empty.
+ */
+bool rmpmc_dequeue(RMpmcQueue *queue, void *out);
+
+/**
+ * @brief Get the number of elements in the queue.
+ * 
+ * The value is exact only when no other thread is using the queue.
+ * 
+ * @param queue A pointer to the RMpmcQueue.
+ * @return The number of elements in the queue.
+ */
+size_t rmpmc_get_size(const RMpmcQueue *queue);
+
+/**
+ * @brief Check if the queue is empty.
+ * 
+ * The answer is exact only when no other thread is using the queue.
+ * 
+ * @param queue A pointer to the RMpmcQueue.
+ * @return true if the queue is empty, false otherwise.
+ */
+bool rmpmc_is_empty(const RMpmcQueue *queue);
+
+/**
+ * @brief Get the capacity of the queue.
+ * 
+ * @param queue A pointer to the RMpmcQueue.
+ * @return The maximum number of elements the queue holds.
+ */
+size_t rmpmc_get_capacity(const RMpmcQueue *queue);
+
+#endif //__RMPMCQUEUE_H__
@@ -0,0 +1,106 @@
+#include "RPool.h"
+
+#include <stdint.h>
+#include <stdalign.h>
+
+typedef struct RPoolSlab
+{
+    struct RPoolSlab *next;
+    void *block;
+    size_t block_size;
+} RPoolSlab;
+
+/* Objects start at the first cache line after the slab header. */
+#define RPOOL_HEADER_SIZE (((sizeof(RPoolSlab) + RPOOL_SLAB_ALIGN - 1) / RPOOL_SLAB_ALIGN) * RPOOL_SLAB_ALIGN)
+
+void rpool_init(RPool *pool, size_t object_size, size_t slab_size, const RAllocator *allocator)
+{
+    size_t align = alignof(max_align_t);
+
+    if (allocator == NULL)
+        allocator = rallocator_default();
+    if (object_size < sizeof(void *))
+        object_size = sizeof(void *);
+    object_size = (object_size + align - 1) / align * align;
+    if (slab_size == 0)
+        slab_size = RPOOL_DEFAULT_SLAB_SIZE;
+    if (slab_size < RPOOL_HEADER_SIZE + object_size)
+        slab_size = RPOOL_HEADER_SIZE + object_size;
+
+    pool->free_list = NULL;
+    pool->cursor = NULL;
+    pool->end = NULL;
+    pool->slabs = NULL;
+    pool->object_size = object_size;
+    pool->slab_size = slab_size;
+    pool->allocator = *allocator;
+}
+
+void rpool_release(RPool *pool)
+{
+    RPoolSlab *slab = pool->slabs;
+    while (slab != NULL)
+    {
+        RPoolSlab *next = slab->next;
+        rallocator_free(&pool->allocator, slab->block, slab->block_size);
+        slab = next;
+    }
+    pool->free_list = NULL;
+    pool->cursor = NULL;
+    pool->end = NULL;
+    pool->slabs = NULL;
+}
+
+bool rpool_merge(RPool *pool, RPool *other)
+{
+    if (pool->object_size != other->object_size || !rallocator_equal(&pool->allocator, &other->allocator))
+        return (false);
+    if (other->slabs == NULL)
+        return (true);
+
+    /* Objects never handed out by other's newest slab go onto the free list. */
+    while (other->cursor != other->end)
+    {
+        rpool_free(pool, other->cursor);
+        other->cursor += other->object_size;
+    }
+
+    void **last = &other->free_list;
+    while (*last != NULL)
+        last = (void **)*last;
+    *last = pool->free_list;
+    pool->free_list = other->free_list;
+
+    RPoolSlab *slab = other->slabs;
+    while (slab->next != NULL)
+        slab = slab->next;
+    slab->next = pool->slabs;
+    pool->slabs = other->slabs;
+
+    other->free_list = NULL;
+    other->cursor = NULL;
+    other->end = NULL;
+    other->slabs = NULL;
+    return (true);
+}
+
+void *rpool_alloc_slab(RPool *pool)
+{
+    size_t block_size = pool->slab_size + RPOOL_SLAB_ALIGN - 1;
+    void *block = rallocator_alloc(&pool->allocator, block_size);
+    if (block == NULL)
+        return (NULL);
+
+    uintptr_t aligned = ((uintptr_t)block + RPOOL_SLAB_ALIGN - 1) & ~(uintptr_t)(RPOOL_SLAB_ALIGN - 1);
+    RPoolSlab *slab = (RPoolSlab *)aligned;
+    slab->next = pool->slabs;
+    slab->block = block;
+    slab->block_size = block_size;
+    pool->slabs = slab;
+
+    size_t count = (pool->slab_size - RPOOL_HEADER_SIZE) / pool->object_size;
+    char *first = (char *)slab + RPOOL_HEADER_SIZE;
+    pool->cursor = first + pool->object_size;
+    pool->end = first + count * pool->object_size;
+    return (first);
+}
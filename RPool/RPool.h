@@ -0,0 +1,129 @@
+/**
+ * @file RPool.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RPOOL_H__
+#define __RPOOL_H__
+
+#include <stddef.h>
+
+#include "RAllocator.h"
+
+/** Alignment of every slab, one cache line. */
+#define RPOOL_SLAB_ALIGN 64
+
+/** Slab size in bytes used when rpool_init is given 0. */
+#define RPOOL_DEFAULT_SLAB_SIZE 4096
+
+struct RPoolSlab;
+
+/**
+ * @brief Pool of fixed-size objects carved from cache-line aligned slabs.
+ *
+ * Released objects go onto a free list and are handed out again before any
+ * new slab is requested, so a workload that allocates and releases at the
+ * same rate stops calling the allocator once the pool is warm. Slabs are
+ * only returned to the allocator by rpool_release.
+ *
+ * The structure is public so containers can embed it; its members are
+ * private to RPool.c.
+ */
+typedef struct RPool
+{
+    void *free_list;
+    char *cursor;
+    char *end;
+    struct RPoolSlab *slabs;
+    size_t object_size;
+    size_t slab_size;
+    RAllocator allocator;
+} RPool;
+
+/**
+ * @brief Initialize an empty pool.
+ *
+ * No memory is allocated until the first rpool_alloc.
+ *
+ * @param pool The pool to initialize.
+ * @param object_size The size of every object in bytes.
+ * @param slab_size The size of each slab in bytes, or 0 for RPOOL_DEFAULT_SLAB_SIZE.
+ * Slabs always hold at least one object.
+ * @param allocator The allocator the slabs come from, or NULL for malloc/free.
+ */
+void rpool_init(RPool *pool, size_t object_size, size_t slab_size, const RAllocator *allocator);
+
+/**
+ * @brief Return every slab to the allocator.
+ *
+ * All objects obtained from the pool become invalid. The pool stays usable.
+ *
+ * @param pool The pool to release.
+ */
+void rpool_release(RPool *pool);
+
+/**
+ * @brief Move every slab and free object of one pool into another.
+ *
+ * Objects taken from other remain valid and now belong to pool; other is left
+ * empty. Both pools must have the same object size and allocator, since the
+ * slabs are later released through pool's allocator. This walks other's free
+ * list and slab chain and the objects not yet handed out from its newest
+ * slab, so it costs O(free objects + slabs of other).
+ *
+ * @param pool The pool receiving the slabs.
+ * @param other The pool to empty.
+ * @return true on success, false (leaving both pools unchanged) if the
+ * object sizes or allocators differ.
+ */
+bool rpool_merge(RPool *pool, RPool *other);
+
+/**
+ * @brief Allocate a new slab and take one object from it.
+ *
+ * Slow path of rpool_alloc; call rpool_alloc instead.
+ *
+ * @param pool The pool to grow.
+ * @return A pointer to an object, or NULL if the allocator failed.
+ */
+void *rpool_alloc_slab(RPool *pool);
+
+/**
+ * @brief Take an object from the pool.
+ *
+ * @param pool The pool to allocate from.
+ * @return A pointer to an uninitialized object, or NULL if the allocator failed.
+ */
+static inline void *rpool_alloc(RPool *pool)
+{
+    void *object = pool->free_list;
+    if (object != NULL)
+    {
+        pool->free_list = *(void **)object;
+        return (object);
+    }
+    if (pool->cursor != pool->end)
+    {
+        object = pool->cursor;
+        pool->cursor += pool->object_size;
+        return (object);
+    }
+    return (rpool_alloc_slab(pool));
+}
+
+/**
+ * @brief Give an object back to the pool.
+ *
+ * @param pool The pool the object was taken from.
+ * @param object The object to release, or NULL.
+ */
+static inline void rpool_free(RPool *pool, void *object)
+{
+    if (object == NULL)
+        return;
+    *(void **)object = pool->free_list;
+    pool->free_list = object;
+}
+
+#endif //__RPOOL_H__
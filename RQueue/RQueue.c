@@ -1,27 +1,45 @@
+#include "RQueue.h"
 #include "RList.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct RQueue { RList *list; } RQueue;
+typedef struct RQueue { RList *list; RAllocator allocator; } RQueue;
 
 RQueue *rqueue_init(size_t type_size)
 {
-    RQueue *queue = (RQueue *)malloc(sizeof(RQueue));
-    queue->list = rlist_init(type_size, NULL, NULL);
+    return (rqueue_init_alloc(type_size, NULL));
+}
+
+RQueue *rqueue_init_alloc(size_t type_size, const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RQueue *queue = (RQueue *)rallocator_alloc(allocator, sizeof(RQueue));
+    if (queue == NULL)
+        return (NULL);
+    queue->allocator = *allocator;
+    queue->list = rlist_init_alloc(type_size, NULL, NULL, allocator);
+    if (queue->list == NULL)
+    {
+        rallocator_free(allocator, queue, sizeof(RQueue));
+        return (NULL);
+    }
     return (queue);
 }
 
 void rqueue_destroy(RQueue *queue)
 {
+    RAllocator allocator = queue->allocator;
     rlist_destroy(queue->list);
-    free(queue);
+    rallocator_free(&allocator, queue, sizeof(RQueue));
 }
 
-void rqueue_enqueue(RQueue *queue, void *data)
+bool rqueue_enqueue(RQueue *queue, void *data)
 {
-    rlist_insert_back(queue->list, data);
+    return (rlist_insert_back(queue->list, data));
 }
 
 void *rqueue_dequeue(RQueue *queue)
@@ -6,8 +6,11 @@
 #ifndef __RQUEUE_H__
 #define __RQUEUE_H__
 
+#include <stddef.h>
 #include <stdbool.h>
 
+#include "RAllocator.h"
+
 /**
  * @struct RQueue
  * @brief Structure representing a resizable queue.
@@ -23,10 +26,22 @@ typedef struct RQueue RQueue; /** Typedef for RQueue structure. */
  * @brief Initialize a resizable queue.
  * 
  * @param type_size The size of each element in the queue.
- * @return A pointer to the newly initialized RQueue.
+ * @return A pointer to the newly initialized RQueue, or NULL if the allocation failed.
  */
 RQueue *rqueue_init(size_t type_size);
 
+/**
+ * @brief Initialize a resizable queue that uses a custom allocator.
+ * 
+ * Same as rqueue_init, but the queue and its nodes are obtained from the
+ * given allocator instead of malloc.
+ * 
+ * @param type_size The size of each element in the queue.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the newly initialized RQueue, or NULL if the allocation failed.
+ */
+RQueue *rqueue_init_alloc(size_t type_size, const RAllocator *allocator);
+
 /**
  * @brief Destroy a resizable queue.
  * 
@@ -41,8 +56,9 @@ void rqueue_destroy(RQueue *queue);
  * 
  * @param queue A pointer to the RQueue.
  * @param data A pointer to the data to be added to the queue.
+ * @return true on success, false if a node could not be allocated (the queue is unchanged).
  */
-void rqueue_enqueue(RQueue *queue, void *data);
+bool rqueue_enqueue(RQueue *queue, void *data);
 
 /**
  * @brief Remove and return the front element from the queue.
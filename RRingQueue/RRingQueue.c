@@ -0,0 +1,135 @@
+#include "RRingQueue.h"
+#include "RCopy.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct RRingQueue
+{
+    unsigned char *data;
+    size_t capacity;
+    size_t mask;
+    size_t head;
+    size_t size;
+    size_t type_size;
+    RAllocator allocator;
+} RRingQueue;
+
+#define RRQUEUE_SLOT(queue, i) ((queue)->data + ((i) & (queue)->mask) * (queue)->type_size)
+
+/* Double the capacity, unwrapping the elements so the front ends up at index 0. */
+static bool rrqueue_grow(RRingQueue *queue)
+{
+    size_t capacity = queue->capacity * 2;
+    unsigned char *data = (unsigned char *)rallocator_alloc(&queue->allocator, capacity * queue->type_size);
+    if (data == NULL)
+        return (false);
+
+    size_t first = queue->capacity - queue->head;
+    if (first > queue->size)
+        first = queue->size;
+    memcpy(data, RRQUEUE_SLOT(queue, queue->head), first * queue->type_size);
+    memcpy(data + first * queue->type_size, queue->data, (queue->size - first) * queue->type_size);
+
+    rallocator_free(&queue->allocator, queue->data, queue->capacity * queue->type_size);
+    queue->data = data;
+    queue->capacity = capacity;
+    queue->mask = capacity - 1;
+    queue->head = 0;
+    return (true);
+}
+
+RRingQueue *rrqueue_init(size_t capacity, size_t type_size)
+{
+    return (rrqueue_init_alloc(capacity, type_size, NULL));
+}
+
+RRingQueue *rrqueue_init_alloc(size_t capacity, size_t type_size, const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    RRingQueue *queue = (RRingQueue *)rallocator_alloc(allocator, sizeof(RRingQueue));
+    if (queue == NULL)
+        return (NULL);
+    queue->allocator = *allocator;
+    queue->capacity = rounded;
+    queue->mask = rounded - 1;
+    queue->head = 0;
+    queue->size = 0;
+    queue->type_size = type_size;
+    queue->data = (unsigned char *)rallocator_alloc(allocator, rounded * type_size);
+    if (queue->data == NULL)
+    {
+        rallocator_free(allocator, queue, sizeof(RRingQueue));
+        return (NULL);
+    }
+    return (queue);
+}
+
+void rrqueue_destroy(RRingQueue *queue)
+{
+    RAllocator allocator = queue->allocator;
+    rallocator_free(&allocator, queue->data, queue->capacity * queue->type_size);
+    rallocator_free(&allocator, queue, sizeof(RRingQueue));
+}
+
+bool rrqueue_enqueue(RRingQueue *queue, const void *data)
+{
+    if (queue->size == queue->capacity && !rrqueue_grow(queue))
+        return (false);
+    rcopy_element(RRQUEUE_SLOT(queue, queue->head + queue->size), data, queue->type_size);
+    queue->size++;
+    return (true);
+}
+
+bool rrqueue_dequeue(RRingQueue *queue, void *out)
+{
+    if (queue->size == 0)
+        return (false);
+    if (out != NULL)
+        rcopy_element(out, RRQUEUE_SLOT(queue, queue->head), queue->type_size);
+    queue->head = (queue->head + 1) & queue->mask;
+    queue->size--;
+    return (true);
+}
+
+void *rrqueue_get_front(const RRingQueue *queue)
+{
+    if (queue->size == 0)
+        return (NULL);
+    return (RRQUEUE_SLOT(queue, queue->head));
+}
+
+void *rrqueue_get_back(const RRingQueue *queue)
+{
+    if (queue->size == 0)
+        return (NULL);
+    return (RRQUEUE_SLOT(queue, queue->head + queue->size - 1));
+}
+
+bool rrqueue_is_empty(const RRingQueue *queue)
+{
+    return (queue->size == 0);
+}
+
+size_t rrqueue_get_size(const RRingQueue *queue)
+{
+    return (queue->size);
+}
+
+size_t rrqueue_get_capacity(const RRingQueue *queue)
+{
+    return (queue->capacity);
+}
+
+void rrqueue_print(const RRingQueue *queue, void (*print)(void *data))
+{
+    for (size_t i = 0; i < queue->size; i++)
+        print(RRQUEUE_SLOT(queue, queue->head + i));
+}
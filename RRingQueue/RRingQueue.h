@@ -0,0 +1,118 @@
+/**
+ * @file RRingQueue.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+#ifndef __RRINGQUEUE_H__
+#define __RRINGQUEUE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+/**
+ * @struct RRingQueue
+ * @brief Structure representing a queue stored in a circular buffer.
+ * 
+ * Elements are copied into a power-of-two sized array and addressed with a
+ * mask, so enqueue and dequeue are O(1) and only allocate when the buffer is
+ * full. Growing doubles the buffer and unwraps the elements into it.
+ */
+struct RRingQueue;
+
+typedef struct RRingQueue RRingQueue; /** Typedef for RRingQueue structure. */
+
+/**
+ * @brief Initialize a ring buffer queue.
+ * 
+ * @param capacity The initial capacity, rounded up to a power of two (at least 2).
+ * @param type_size The size of each element in the queue.
+ * @return A pointer to the newly initialized RRingQueue, or NULL if the allocation failed.
+ */
+RRingQueue *rrqueue_init(size_t capacity, size_t type_size);
+
+/**
+ * @brief Initialize a ring buffer queue that uses a custom allocator.
+ * 
+ * @param capacity The initial capacity, rounded up to a power of two (at least 2).
+ * @param type_size The size of each element in the queue.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the newly initialized RRingQueue, or NULL if the allocation failed.
+ */
+RRingQueue *rrqueue_init_alloc(size_t capacity, size_t type_size, const RAllocator *allocator);
+
+/**
+ * @brief Destroy a ring buffer queue.
+ * 
+ * @param queue A pointer to the RRingQueue to be destroyed.
+ */
+void rrqueue_destroy(RRingQueue *queue);
+
+/**
+ * @brief Copy an element to the back of the queue.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @param data A pointer to the type_size bytes to be added.
+ * @return true on success, false if the queue could not grow.
+ */
+bool rrqueue_enqueue(RRingQueue *queue, const void *data);
+
+/**
+ * @brief Remove the front element from the queue.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @param out Receives a copy of the removed element, or NULL to discard it.
+ * @return true if an element was removed, false if the queue was empty.
+ */
+bool rrqueue_dequeue(RRingQueue *queue, void *out);
+
+/**
+ * @brief Get the front element of the queue without removing it.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @return A pointer to the front element, valid until the queue is modified, or NULL if it is empty.
+ */
+void *rrqueue_get_front(const RRingQueue *queue);
+
+/**
+ * @brief Get the back element of the queue without removing it.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @return A pointer to the back element, valid until the queue is modified, or NULL if it is empty.
+ */
+void *rrqueue_get_back(const RRingQueue *queue);
+
+/**
+ * @brief Check if the queue is empty.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @return true if the queue is empty, false otherwise.
+ */
+bool rrqueue_is_empty(const RRingQueue *queue);
+
+/**
+ * @brief Get the current size of the queue.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @return The number of elements in the queue.
+ */
+size_t rrqueue_get_size(const RRingQueue *queue);
+
+/**
+ * @brief Get the current capacity of the queue.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @return The number of elements the queue holds before it has to grow.
+ */
+size_t rrqueue_get_capacity(const RRingQueue *queue);
+
+/**
+ * @brief Print the contents of the queue from front to back.
+ * 
+ * @param queue A pointer to the RRingQueue.
+ * @param print A function pointer to a function that prints an individual element.
+ */
+void rrqueue_print(const RRingQueue *queue, void (*print)(void *data));
+
+#endif //__RRINGQUEUE_H__
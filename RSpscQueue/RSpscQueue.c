@@ -0,0 +1,178 @@
+#include "RSpscQueue.h"
+#include "RCopy.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+
+#define RSPSC_CACHE_LINE 64
+
+typedef struct RSpscQueue
+{
+    /* Written by the producer. */
+    alignas(RSPSC_CACHE_LINE) atomic_size_t tail;
+    size_t cached_head;
+
+    /* Written by the consumer. */
+    alignas(RSPSC_CACHE_LINE) atomic_size_t head;
+    size_t cached_tail;
+
+    /* Read-only after initialization. */
+    alignas(RSPSC_CACHE_LINE) unsigned char *data;
+    size_t capacity;
+    size_t mask;
+    size_t type_size;
+    void *block;
+    size_t block_size;
+    RAllocator allocator;
+} RSpscQueue;
+
+#define RSPSC_SLOT(queue, i) ((queue)->data + ((i) & (queue)->mask) * (queue)->type_size)
+
+/* Copy count elements between the ring (starting at index) and a flat buffer. */
+static void rspsc_copy_ring(RSpscQueue *queue, size_t index, void *flat, size_t count, bool to_ring)
+{
+    size_t first = queue->capacity - (index & queue->mask);
+    if (first > count)
+        first = count;
+    size_t first_bytes = first * queue->type_size;
+    size_t rest_bytes = (count - first) * queue->type_size;
+
+    if (to_ring)
+    {
+        memcpy(RSPSC_SLOT(queue, index), flat, first_bytes);
+        memcpy(queue->data, (unsigned char *)flat + first_bytes, rest_bytes);
+    }
+    else
+    {
+        memcpy(flat, RSPSC_SLOT(queue, index), first_bytes);
+        memcpy((unsigned char *)flat + first_bytes, queue->data, rest_bytes);
+    }
+}
+
+RSpscQueue *rspsc_init(size_t capacity, size_t type_size)
+{
+    return (rspsc_init_alloc(capacity, type_size, NULL));
+}
+
+RSpscQueue *rspsc_init_alloc(size_t capacity, size_t type_size, const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded *= 2;
+
+    size_t block_size = sizeof(RSpscQueue) + RSPSC_CACHE_LINE - 1;
+    void *block = rallocator_alloc(allocator, block_size);
+    if (block == NULL)
+        return (NULL);
+    uintptr_t aligned = ((uintptr_t)block + RSPSC_CACHE_LINE - 1) & ~(uintptr_t)(RSPSC_CACHE_LINE - 1);
+    RSpscQueue *queue = (RSpscQueue *)aligned;
+
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->cached_head = 0;
+    queue->cached_tail = 0;
+    queue->capacity = rounded;
+    queue->mask = rounded - 1;
+    queue->type_size = type_size;
+    queue->block = block;
+    queue->block_size = block_size;
+    queue->allocator = *allocator;
+    queue->data = (unsigned char *)rallocator_alloc(allocator, rounded * type_size);
+    if (queue->data == NULL)
+    {
+        rallocator_free(allocator, block, block_size);
+        return (NULL);
+    }
+    return (queue);
+}
+
+void rspsc_destroy(RSpscQueue *queue)
+{
+    RAllocator allocator = queue->allocator;
+    rallocator_free(&allocator, queue->data, queue->capacity * queue->type_size);
+    rallocator_free(&allocator, queue->block, queue->block_size);
+}
+
+bool rspsc_try_enqueue(RSpscQueue *queue, const void *data)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (tail - queue->cached_head == queue->capacity)
+    {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cached_head == queue->capacity)
+            return (false);
+    }
+    rcopy_element(RSPSC_SLOT(queue, tail), data, queue->type_size);
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return (true);
+}
+
+bool rspsc_try_dequeue(RSpscQueue *queue, void *out)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head == queue->cached_tail)
+    {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head == queue->cached_tail)
+            return (false);
+    }
+    rcopy_element(out, RSPSC_SLOT(queue, head), queue->type_size);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return (true);
+}
+
+size_t rspsc_try_enqueue_n(RSpscQueue *queue, const void *data, size_t count)
+{
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t space = queue->capacity - (tail - queue->cached_head);
+    if (space < count)
+    {
+        queue->cached_head = atomic_load_explicit(&queue->head, memory_order_acquire);
+        space = queue->capacity - (tail - queue->cached_head);
+    }
+    if (count > space)
+        count = space;
+    if (count == 0)
+        return (0);
+
+    rspsc_copy_ring(queue, tail, (void *)data, count, true);
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    return (count);
+}
+
+size_t rspsc_try_dequeue_n(RSpscQueue *queue, void *out, size_t count)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t available = queue->cached_tail - head;
+    if (available < count)
+    {
+        queue->cached_tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->cached_tail - head;
+    }
+    if (count > available)
+        count = available;
+    if (count == 0)
+        return (0);
+
+    rspsc_copy_ring(queue, head, out, count, false);
+    atomic_store_explicit(&queue->head, head + count, memory_order_release);
+    return (count);
+}
+
+size_t rspsc_get_size(const RSpscQueue *queue)
+{
+    size_t head = atomic_load_explicit(&((RSpscQueue *)queue)->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&((RSpscQueue *)queue)->tail, memory_order_acquire);
+    return (tail - head);
+}
+
+size_t rspsc_get_capacity(const RSpscQueue *queue)
+{
+    return (queue->capacity);
+}
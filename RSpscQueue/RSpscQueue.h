@@ -0,0 +1,117 @@
+/**
+ * @file RSpscQueue.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+#ifndef __RSPSCQUEUE_H__
+#define __RSPSCQUEUE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+/**
+ * @struct RSpscQueue
+ * @brief Bounded wait-free queue for one producer thread and one consumer thread.
+ * 
+ * Elements are copied into a power-of-two ring of slots. The producer only
+ * writes the tail index and the consumer only writes the head index; each
+ * side keeps a cached copy of the other side's index and re-reads it only
+ * when the cached value says the queue is full (or empty), so in steady state
+ * the two threads do not touch each other's cache lines.
+ * 
+ * At most one thread may call the enqueue functions and at most one (other)
+ * thread may call the dequeue functions at any time.
+ */
+struct RSpscQueue;
+
+typedef struct RSpscQueue RSpscQueue; /** Typedef for RSpscQueue structure. */
+
+/**
+ * @brief Initialize a single-producer/single-consumer queue.
+ * 
+ * @param capacity The number of elements the queue holds, rounded up to a power of two.
+ * @param type_size The size of each element in the queue.
+ * @return A pointer to the newly initialized RSpscQueue, or NULL if the allocation failed.
+ */
+RSpscQueue *rspsc_init(size_t capacity, size_t type_size);
+
+/**
+ * @brief Initialize a single-producer/single-consumer queue that uses a custom allocator.
+ * 
+ * @param capacity The number of elements the queue holds, rounded up to a power of two.
+ * @param type_size The size of each element in the queue.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the newly initialized RSpscQueue, or NULL if the allocation failed.
+ */
+RSpscQueue *rspsc_init_alloc(size_t capacity, size_t type_size, const RAllocator *allocator);
+
+/**
+ * @brief Destroy a single-producer/single-consumer queue.
+ * 
+ * No thread may use the queue any more.
+ * 
+ * @param queue A pointer to the RSpscQueue to be destroyed.
+ */
+void rspsc_destroy(RSpscQueue *queue);
+
+/**
+ * @brief Copy an element to the back of the queue if there is room (producer only).
+ * 
+ * @param queue A pointer to the RSpscQueue.
+ * @param data A pointer to the type_size bytes to be added.
+ * @return true if the element was added, false if the queue was full.
+ */
+bool rspsc_try_enqueue(RSpscQueue *queue, const void *data);
+
+/**
+ * @brief Remove the front element of the queue if there is one (consumer only).
+ * 
+ * @param queue A pointer to the RSpscQueue.
+ * @param out Receives a copy of the removed element.
+ * @return true if an element was removed, false if the queue was empty.
+ */
+bool rspsc_try_dequeue(RSpscQueue *queue, void *out);
+
+/**
+ * @brief Copy up to count contiguous elements to the back of the queue (producer only).
+ * 
+ * The elements are published with a single index update.
+ * 
+ * @param queue A pointer to the RSpscQueue.
+ * @param data A pointer to count elements.
+ * @param count The number of elements to add.
+ * @return The number of elements added, 0 if the queue was full.
+ */
+size_t rspsc_try_enqueue_n(RSpscQueue *queue, const void *data, size_t count);
+
+/**
+ * @brief Remove up to count elements from the front of the queue (consumer only).
+ * 
+ * @param queue A pointer to the RSpscQueue.
+ * @param out Receives the removed elements, room for count elements.
+ * @param count The maximum number of elements to remove.
+ * @return The number of elements removed, 0 if the queue was empty.
+ */
+size_t rspsc_try_dequeue_n(RSpscQueue *queue, void *out, size_t count);
+
+/**
+ * @brief Get the number of elements in the queue.
+ * 
+ * The value is exact only when neither side is running concurrently.
+ * 
+ * @param queue A pointer to the RSpscQueue.
+ * @return The number of elements in the queue.
+ */
+size_t rspsc_get_size(const RSpscQueue *queue);
+
+/**
+ * @brief Get the capacity of the queue.
+ * 
+ * @param queue A pointer to the RSpscQueue.
+ * @return The maximum number of elements the queue holds.
+ */
+size_t rspsc_get_capacity(const RSpscQueue *queue);
+
+#endif //__RSPSCQUEUE_H__
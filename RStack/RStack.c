@@ -1,28 +1,45 @@
+#include "RStack.h"
 #include "RList.h"
 
-#include <stdio.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct RStack { RList *list; } RStack;
+typedef struct RStack { RList *list; RAllocator allocator; } RStack;
 
 RStack *rstack_init(size_t type_size)
 {
-    RStack *stack = (RStack *)malloc(sizeof(RStack)); //TODO: Check for errors
-    stack->list = rlist_init(type_size, NULL, NULL); 
+    return (rstack_init_alloc(type_size, NULL));
+}
+
+RStack *rstack_init_alloc(size_t type_size, const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    RStack *stack = (RStack *)rallocator_alloc(allocator, sizeof(RStack));
+    if (stack == NULL)
+        return (NULL);
+    stack->allocator = *allocator;
+    stack->list = rlist_init_alloc(type_size, NULL, NULL, allocator);
+    if (stack->list == NULL)
+    {
+        rallocator_free(allocator, stack, sizeof(RStack));
+        return (NULL);
+    }
     return (stack);
 }
 
 void rstack_destroy(RStack *stack)
 {
+    RAllocator allocator = stack->allocator;
     rlist_destroy(stack->list);
-    free(stack);
+    rallocator_free(&allocator, stack, sizeof(RStack));
 }
 
-void rstack_push(RStack *stack, void *data)
+bool rstack_push(RStack *stack, void *data)
 {
-    rlist_insert_front(stack->list, data);
+    return (rlist_insert_front(stack->list, data));
 }
 
 void *rstack_pop(RStack *stack)
@@ -7,8 +7,11 @@
 #ifndef __RSTACK_H__
 #define __RSTACK_H__
 
+#include <stddef.h>
 #include <stdbool.h>
 
+#include "RAllocator.h"
+
 struct RStack;
 typedef struct RStack RStack;
 
@@ -19,10 +22,22 @@ typedef struct RStack RStack;
  * It requires the size of the data type.
  *
  * @param type_size The size (in bytes) of the data type.
- * @return A pointer to the initialized stack.
+ * @return A pointer to the initialized stack, or NULL if the allocation failed.
  */
 RStack *rstack_init(size_t type_size);
 
+/**
+ * @brief Initialize a resizable stack that uses a custom allocator.
+ *
+ * Same as rstack_init, but the stack and its nodes are obtained from the given
+ * allocator instead of malloc.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized stack, or NULL if the allocation failed.
+ */
+RStack *rstack_init_alloc(size_t type_size, const RAllocator *allocator);
+
 /**
  * @brief Destroy a resizable stack.
  *
@@ -40,8 +55,9 @@ void rstack_destroy(RStack *stack);
  *
  * @param stack A pointer to the RStack.
  * @param data A pointer to the data to be pushed onto the stack.
+ * @return true on success, false if a node could not be allocated (the stack is unchanged).
  */
-void rstack_push(RStack *stack, void *data);
+bool rstack_push(RStack *stack, void *data);
 
 /**
  * @brief Pop the top element from the resizable stack.
@@ -0,0 +1,406 @@
+#include "RUList.h"
+#include "RAllocator.h"
+#include "RPool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct RUNode
+{
+    struct RUNode *prev;
+    struct RUNode *next;
+    size_t count;
+    unsigned char data[];
+} RUNode;
+
+typedef struct RUList
+{
+    RUNode *head;
+    RUNode *tail;
+    size_t size;
+    size_t type_size;
+    size_t node_capacity;
+    void (*free_data)(void *);
+    int64_t (*compare)(void *, void *);
+    RAllocator allocator;
+    RPool pool;
+} RUList;
+
+#define RUNODE_AT(list, node, i) ((node)->data + (size_t)(i) * (list)->type_size)
+
+static RUNode *runode_create(RUList *list)
+{
+    RUNode *node = (RUNode *)rpool_alloc(&list->pool);
+    if (node == NULL)
+        return (NULL);
+    node->prev = node->next = NULL;
+    node->count = 0;
+    return (node);
+}
+
+/* Link new_node into the list right after node (or at the front if node is NULL). */
+static void runode_link_after(RUList *list, RUNode *node, RUNode *new_node)
+{
+    new_node->prev = node;
+    new_node->next = (node != NULL) ? node->next : list->head;
+    if (new_node->next != NULL)
+        new_node->next->prev = new_node;
+    else
+        list->tail = new_node;
+    if (node != NULL)
+        node->next = new_node;
+    else
+        list->head = new_node;
+}
+
+static void runode_unlink(RUList *list, RUNode *node)
+{
+    if (node->prev != NULL)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+    if (node->next != NULL)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+    rpool_free(&list->pool, node);
+}
+
+/* Find the node holding element index and the element's offset inside it. */
+static RUNode *rulist_locate(const RUList *list, size_t index, size_t *offset)
+{
+    RUNode *node = NULL;
+
+    if (index < list->size / 2)
+    {
+        node = list->head;
+        while (index >= node->count)
+        {
+            index -= node->count;
+            node = node->next;
+        }
+    }
+    else
+    {
+        size_t from_back = list->size - index;
+        node = list->tail;
+        while (from_back > node->count)
+        {
+            from_back -= node->count;
+            node = node->prev;
+        }
+        index = node->count - from_back;
+    }
+
+    *offset = index;
+    return (node);
+}
+
+/* Insert data at position offset of node, splitting the node first if it is full. */
+static bool runode_insert(RUList *list, RUNode *node, size_t offset, const void *data)
+{
+    if (node->count == list->node_capacity)
+    {
+        RUNode *new_node = runode_create(list);
+        if (new_node == NULL)
+            return (false);
+        size_t keep = node->count / 2;
+
+        new_node->count = node->count - keep;
+        memcpy(new_node->data, RUNODE_AT(list, node, keep), new_node->count * list->type_size);
+        node->count = keep;
+        runode_link_after(list, node, new_node);
+
+        if (offset > keep)
+        {
+            offset -= keep;
+            node = new_node;
+        }
+    }
+
+    memmove(RUNODE_AT(list, node, offset + 1), RUNODE_AT(list, node, offset),
+        (node->count - offset) * list->type_size);
+    memcpy(RUNODE_AT(list, node, offset), data, list->type_size);
+    node->count++;
+    list->size++;
+    return (true);
+}
+
+/* Remove the element at position offset of node, merging sparse neighbours. */
+static void runode_remove(RUList *list, RUNode *node, size_t offset)
+{
+    if (list->free_data != NULL)
+        list->free_data(RUNODE_AT(list, node, offset));
+
+    node->count--;
+    memmove(RUNODE_AT(list, node, offset), RUNODE_AT(list, node, offset + 1),
+        (node->count - offset) * list->type_size);
+    list->size--;
+
+    if (node->count == 0)
+    {
+        runode_unlink(list, node);
+        return;
+    }
+
+    RUNode *next = node->next;
+    if (next != NULL && node->count < list->node_capacity / 4
+        && node->count + next->count <= list->node_capacity)
+    {
+        memcpy(RUNODE_AT(list, node, node->count), next->data, next->count * list->type_size);
+        node->count += next->count;
+        runode_unlink(list, next);
+    }
+}
+
+RUList *rulist_init(size_t type_size, int64_t (*compare)(void *, void *), void (*free_data)(void *))
+{
+    return (rulist_init_alloc(type_size, compare, free_data, NULL));
+}
+
+RUList *rulist_init_alloc(size_t type_size, int64_t (*compare)(void *, void *),
+    void (*free_data)(void *), const RAllocator *allocator)
+{
+    if (allocator == NULL)
+        allocator = rallocator_default();
+
+    size_t capacity = (RULIST_NODE_SIZE - sizeof(RUNode)) / type_size;
+    if (capacity < RULIST_MIN_NODE_CAPACITY)
+        capacity = RULIST_MIN_NODE_CAPACITY;
+
+    RUList *list = (RUList *)rallocator_alloc(allocator, sizeof(RUList));
+    if (list == NULL)
+        return (NULL);
+    list->allocator = *allocator;
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->type_size = type_size;
+    list->node_capacity = capacity;
+    list->compare = compare;
+    list->free_data = free_data;
+    rpool_init(&list->pool, sizeof(RUNode) + capacity * type_size, 0, allocator);
+    return (list);
+}
+
+void rulist_destroy(RUList *list)
+{
+    rulist_clear(list);
+    RAllocator allocator = list->allocator;
+    rallocator_free(&allocator, list, sizeof(RUList));
+}
+
+void rulist_clear(RUList *list)
+{
+    if (list->free_data != NULL)
+    {
+        for (RUNode *node = list->head; node != NULL; node = node->next)
+        {
+            for (size_t i = 0; i < node->count; i++)
+                list->free_data(RUNODE_AT(list, node, i));
+        }
+    }
+    rpool_release(&list->pool);
+    list->head = list->tail = NULL;
+    list->size = 0;
+}
+
+bool rulist_insert_back(RUList *list, void *data)
+{
+    RUNode *tail = list->tail;
+    if (tail == NULL || tail->count == list->node_capacity)
+    {
+        tail = runode_create(list);
+        if (tail == NULL)
+            return (false);
+        runode_link_after(list, list->tail, tail);
+    }
+    memcpy(RUNODE_AT(list, tail, tail->count), data, list->type_size);
+    tail->count++;
+    list->size++;
+    return (true);
+}
+
+bool rulist_insert_front(RUList *list, void *data)
+{
+    RUNode *head = list->head;
+    if (head == NULL || head->count == list->node_capacity)
+    {
+        head = runode_create(list);
+        if (head == NULL)
+            return (false);
+        runode_link_after(list, NULL, head);
+    }
+    return (runode_insert(list, head, 0, data));
+}
+
+bool rulist_insert_at(RUList *list, void *data, size_t index)
+{
+    if (index > list->size)
+        return (false);
+    else if (index == list->size)
+        return (rulist_insert_back(list, data));
+
+    size_t offset = 0;
+    RUNode *node = rulist_locate(list, index, &offset);
+    return (runode_insert(list, node, offset, data));
+}
+
+bool rulist_insert_sorted(RUList *list, void *data)
+{
+    for (RUNode *node = list->head; node != NULL; node = node->next)
+    {
+        if (list->compare(data, RUNODE_AT(list, node, node->count - 1)) < 0)
+            continue;
+
+        size_t offset = 0;
+        while (list->compare(data, RUNODE_AT(list, node, offset)) < 0)
+            offset++;
+        return (runode_insert(list, node, offset, data));
+    }
+    return (rulist_insert_back(list, data));
+}
+
+void rulist_remove_front(RUList *list)
+{
+    runode_remove(list, list->head, 0);
+}
+
+void rulist_remove_back(RUList *list)
+{
+    runode_remove(list, list->tail, list->tail->count - 1);
+}
+
+void rulist_remove(RUList *list, void *element)
+{
+    for (RUNode *node = list->head; node != NULL; node = node->next)
+    {
+        for (size_t i = 0; i < node->count; i++)
+        {
+            if (memcmp(element, RUNODE_AT(list, node, i), list->type_size) == 0)
+            {
+                runode_remove(list, node, i);
+                return;
+            }
+        }
+    }
+}
+
+void rulist_remove_at(RUList *list, size_t index)
+{
+    if (index >= list->size)
+        return;
+
+    size_t offset = 0;
+    RUNode *node = rulist_locate(list, index, &offset);
+    runode_remove(list, node, offset);
+}
+
+void rulist_reverse(RUList *list)
+{
+    unsigned char *swap = (unsigned char *)rallocator_alloc(&list->allocator, list->type_size);
+    RUNode *node = list->head;
+
+    while (node != NULL)
+    {
+        RUNode *next = node->next;
+        for (size_t i = 0, j = node->count - 1; i < j; i++, j--)
+        {
+            memcpy(swap, RUNODE_AT(list, node, i), list->type_size);
+            memcpy(RUNODE_AT(list, node, i), RUNODE_AT(list, node, j), list->type_size);
+            memcpy(RUNODE_AT(list, node, j), swap, list->type_size);
+        }
+        node->next = node->prev;
+        node->prev = next;
+        node = next;
+    }
+
+    node = list->head;
+    list->head = list->tail;
+    list->tail = node;
+    rallocator_free(&list->allocator, swap, list->type_size);
+}
+
+void *rulist_get_head(const RUList *list)
+{
+    return (list->head->data);
+}
+
+void *rulist_get_tail(const RUList *list)
+{
+    return (RUNODE_AT(list, list->tail, list->tail->count - 1));
+}
+
+size_t rulist_get_size(const RUList *list)
+{
+    return (list->size);
+}
+
+void *rulist_get_element(const RUList *list, size_t index)
+{
+    if (index >= list->size)
+        return (NULL);
+
+    size_t offset = 0;
+    RUNode *node = rulist_locate(list, index, &offset);
+    return (RUNODE_AT(list, node, offset));
+}
+
+void *rulist_get_medium(const RUList *list)
+{
+    return (rulist_get_element(list, list->size / 2));
+}
+
+bool rulist_is_empty(const RUList *list)
+{
+    return (list->size == 0);
+}
+
+bool rulist_contains(const RUList *list, const void *element)
+{
+    return (rulist_contains_at(list, element) >= 0);
+}
+
+int64_t rulist_contains_at(const RUList *list, const void *element)
+{
+    const unsigned char first = *(const unsigned char *)element;
+    int64_t index = 0;
+    for (RUNode *node = list->head; node != NULL; node = node->next)
+    {
+        const unsigned char *data = node->data;
+        for (size_t i = 0; i < node->count; i++, data += list->type_size)
+        {
+            /* Checking the first byte inline skips most memcmp calls. */
+            if (*data == first && memcmp(element, data, list->type_size) == 0)
+                return (index + (int64_t)i);
+        }
+        index += (int64_t)node->count;
+    }
+    return (-1);
+}
+
+bool rulist_is_sorted(const RUList *list)
+{
+    void *prev = NULL;
+    for (RUNode *node = list->head; node != NULL; node = node->next)
+    {
+        for (size_t i = 0; i < node->count; i++)
+        {
+            void *current = RUNODE_AT(list, node, i);
+            if (prev != NULL && list->compare(prev, current) < 0)
+                return (false);
+            prev = current;
+        }
+    }
+    return (true);
+}
+
+void rulist_print(const RUList *list, void (*print)(void *))
+{
+    for (RUNode *node = list->head; node != NULL; node = node->next)
+    {
+        for (size_t i = 0; i < node->count; i++)
+            print(RUNODE_AT(list, node, i));
+    }
+}
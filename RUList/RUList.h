@@ -0,0 +1,293 @@
+/**
+ * @file RUList.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15 
+ */
+
+#ifndef __RULIST_H__
+#define __RULIST_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "RAllocator.h"
+
+/** Target size in bytes of one unrolled list node, header included. */
+#define RULIST_NODE_SIZE 256
+
+/** Minimum number of elements per node, used for large element types. */
+#define RULIST_MIN_NODE_CAPACITY 4
+
+/**
+ * @brief Unrolled linked list.
+ *
+ * RUList offers the RList interface but stores elements by value, packing as
+ * many as fit in RULIST_NODE_SIZE bytes into each node. Scans run over
+ * contiguous memory and indexed access skips whole nodes. Element pointers
+ * returned by the list point into the nodes and stay valid only until the
+ * list is modified.
+ */
+struct RUList;
+typedef struct RUList RUList;
+
+/**
+ * @brief Initialize a list for storing elements of a specified data type.
+ *
+ * This function initializes a list to store elements of a specified data type.
+ * It requires the size of the data type, a comparison function, and an optional
+ * function called on every element when it is removed or the list is destroyed.
+ * Inserted elements are copied into the list.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param compare A pointer to a function for comparing two elements of the desired data type.
+ * @param free_data A pointer to a function releasing resources owned by an element, or NULL.
+ * @return A pointer to the initialized list, or NULL if the allocation failed.
+ */
+RUList *rulist_init(size_t type_size, 
+    int64_t (*compare)(void *, void *),
+    void (*free_data)(void *));
+
+/**
+ * @brief Initialize a list that uses a custom allocator.
+ *
+ * Same as rulist_init, but the list and its nodes are obtained from the given
+ * allocator instead of malloc.
+ *
+ * @param type_size The size (in bytes) of the data type.
+ * @param compare A pointer to a function for comparing two elements of the desired data type.
+ * @param free_data A pointer to a function releasing resources owned by an element, or NULL.
+ * @param allocator The allocator to use, or NULL for malloc/free.
+ * @return A pointer to the initialized list, or NULL if the allocation failed.
+ */
+RUList *rulist_init_alloc(size_t type_size,
+    int64_t (*compare)(void *, void *),
+    void (*free_data)(void *),
+    const RAllocator *allocator);
+
+/**
+ * @brief Destroy the list and deallocate all associated memory.
+ *
+ * This function destroys the list and deallocates all memory associated with it.
+ * Nodes come from slabs owned by the list, so this releases the slabs instead of
+ * freeing every node; the list is only walked when it has a free_data function.
+ *
+ * @param list A pointer to the list to be destroyed.
+ */
+void rulist_destroy(RUList *list);
+
+/**
+ * @brief Insert an element at the end of the list.
+ *
+ * This function inserts an element at the end of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be inserted.
+ * @return true on success, false if a node could not be allocated (the list is unchanged).
+ */
+bool rulist_insert_back(RUList *list, void *data);
+
+/**
+ * @brief Insert an element at the beginning of the list.
+ *
+ * This function inserts an element at the beginning of the list.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be inserted.
+ * @return true on success, false if a node could not be allocated (the list is unchanged).
+ */
+bool rulist_insert_front(RUList *list, void *data);
+
+/**
+ * @brief Insert an element at the specified index.
+ *
+ * This function inserts an element at the specified index in the list. An
+ * index equal to the size appends; larger indices are ignored. A full node is
+ * split in two.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be inserted.
+ * @param index The position at which to insert the element.
+ * @return true on success, false if index is out of range or a node could not
+ * be allocated (the list is unchanged).
+ */
+bool rulist_insert_at(RUList *list, void *data, size_t index);
+
+/**
+ * @brief Insert an element into the list in a sorted order.
+ *
+ * This function inserts an element into the list in a sorted order, based on
+ * the comparison function provided during initialization.
+ *
+ * @param list A pointer to the list.
+ * @param data A pointer to the data to be inserted.
+ * @return true on success, false if a node could not be allocated (the list is unchanged).
+ */
+bool rulist_insert_sorted(RUList *list, void *data);
+
+/**
+ * @brief Clear all elements from the list.
+ *
+ * This function removes all elements from the list and returns the node slabs
+ * to the allocator.
+ *
+ * @param list A pointer to the list.
+ */
+void rulist_clear(RUList *list);
+
+/**
+ * @brief Remove the element at the end of the list.
+ *
+ * This function removes the element at the end of the list.
+ *
+ * @param list A pointer to the list.
+ */
+void rulist_remove_back(RUList *list);
+
+
+/**
+ * @brief Remove the element at the beginning of the list.
+ *
+ * This function removes the element at the beginning of the list.
+ *
+ * @param list A pointer to the list.
+ */
+void rulist_remove_front(RUList *list);
+
+
+/**
+ * @brief Remove a specific element from the list.
+ *
+ * This function removes a specific element from the list.
+ *
+ * @param list A pointer to the list.
+ * @param element A pointer to the element to be removed.
+ */
+void rulist_remove(RUList *list, void *element);
+
+
+/**
+ * @brief Remove the element at the specified index.
+ *
+ * This function removes the element at the specified index from the list.
+ *
+ * @param list A pointer to the list.
+ * @param index The index of the element to be removed.
+ */
+void rulist_remove_at(RUList *list, size_t index);
+
+/**
+ * @brief Reverse the order of elements in the list.
+ *
+ * This function reverses the order of elements in the list.
+ *
+ * @param list A pointer to the list.
+ */
+void rulist_reverse(RUList *list);
+
+/**
+ * @brief Get the first element of the list.
+ *
+ * This function returns a pointer to the first element of the list.
+ *
+ * @param list A pointer to the list.
+ * @return A pointer to the first element of the list.
+ */
+void *rulist_get_head(const RUList *list);
+
+/**
+ * @brief Get the last element of the list.
+ *
+ * This function returns a pointer to the last element of the list.
+ *
+ * @param list A pointer to the list.
+ * @return A pointer to the last element of the list.
+ */
+void *rulist_get_tail(const RUList *list);
+
+/**
+ * @brief Get the number of elements in the list.
+ *
+ * This function returns the number of elements currently stored in the list.
+ *
+ * @param list A pointer to the list.
+ * @return The number of elements in the list.
+ */
+size_t rulist_get_size(const RUList *list);
+
+/**
+ * @brief Get the median element of the list.
+ *
+ * This function returns a pointer to the median element of the list.
+ *
+ * @param list A pointer to the list.
+ * @return A pointer to the median element of the list.
+ */
+void *rulist_get_medium(const RUList *list);
+
+/**
+ * @brief Get the element at the specified index.
+ *
+ * This function returns a pointer to the element at the specified index,
+ * skipping whole nodes from whichever end of the list is closer.
+ *
+ * @param list A pointer to the list.
+ * @param index The index of the element to retrieve.
+ * @return A pointer to the element at the specified index.
+ */
+void *rulist_get_element(const RUList *list, size_t index);
+
+/**
+ * @brief Check if the list is empty.
+ *
+ * This function checks if the list is empty.
+ *
+ * @param list A pointer to the list.
+ * @return true if the list is empty, otherwise false.
+ */
+bool rulist_is_empty(const RUList *list);
+
+/**
+ * @brief Check if the list contains a specific element.
+ *
+ * This function checks if the list contains a specific element.
+ *
+ * @param list A pointer to the list.
+ * @param element A pointer to the element to be checked.
+ * @return true if the list contains the element, otherwise false.
+ */
+bool rulist_contains(const RUList *list, const void *element);
+
+/**
+ * @brief Check if the list contains a specific element at a given index.
+ *
+ * This function checks if the list contains a specific element at a given index.
+ *
+ * @param list A pointer to the list.
+ * @param element A pointer to the element to be checked.
+ * @return The index of the element if found, otherwise -1.
+ */
+int64_t rulist_contains_at(const RUList *list, const void *element);
+
+/**
+ * @brief Check if the list is sorted.
+ *
+ * This function checks if the list is sorted based on the comparison function provided
+ * during initialization.
+ *
+ * @param list A pointer to the list.
+ * @return true if the list is sorted, otherwise false.
+ */
+bool rulist_is_sorted(const RUList *list);
+
+/**
+ * @brief Print the elements of the list for debugging purposes.
+ *
+ * This function prints the elements of the list for debugging purposes.
+ *
+ * @param list A pointer to the list.
+ * @param print A function pointer for printing elements of any data type.
+ */
+void rulist_print(const RUList *list, void (*print)(void*));
+
+#endif //__RULIST_H__
@@ -0,0 +1,261 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "RBench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+volatile uint64_t rbench_sink;
+
+static atomic_uint_fast64_t rbench_allocs;
+static atomic_uint_fast64_t rbench_frees;
+
+#ifdef RBENCH_WRAP_ALLOC
+/* Linked with -Wl,--wrap=..., so every allocation made by the containers is counted here. */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size)
+{
+    atomic_fetch_add_explicit(&rbench_allocs, 1, memory_order_relaxed);
+    return (__real_malloc(size));
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    atomic_fetch_add_explicit(&rbench_allocs, 1, memory_order_relaxed);
+    return (__real_calloc(count, size));
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    atomic_fetch_add_explicit(&rbench_allocs, 1, memory_order_relaxed);
+    return (__real_realloc(ptr, size));
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr != NULL)
+        atomic_fetch_add_explicit(&rbench_frees, 1, memory_order_relaxed);
+    __real_free(ptr);
+}
+#endif
+
+typedef struct RBenchState
+{
+    const char *name;
+    const RBenchParams *params;
+    uint64_t start_ns;
+    uint64_t start_allocs;
+    uint64_t start_frees;
+    bool reported;
+} RBenchState;
+
+static RBenchState rbench_state;
+static int rbench_status;
+
+static uint64_t rbench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+static void rbench_usage(const char *program)
+{
+    fprintf(stderr,
+        "usage: %s [--min N] [--max N] [--sizes A,B,...] [--threads N] [--filter SUBSTRING]\n"
+        "  --min, --max  element counts to run, stepping by powers of ten (default 1000..1000000)\n"
+        "  --sizes       element sizes in bytes, at least 4 (default 4,16,64)\n"
+        "  --threads     upper bound for multi-threaded cases (default: online CPUs)\n"
+        "  --filter      only run cases whose name contains SUBSTRING\n",
+        program);
+    exit(2);
+}
+
+void rbench_parse_options(RBenchOptions *options, int argc, char **argv)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    options->min_count = 1000;
+    options->max_count = 1000000;
+    options->elem_sizes[0] = 4;
+    options->elem_sizes[1] = 16;
+    options->elem_sizes[2] = 64;
+    options->elem_size_count = 3;
+    options->max_threads = cpus > 0 ? (size_t)cpus : 1;
+    options->filter = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (i + 1 >= argc)
+            rbench_usage(argv[0]);
+
+        const char *value = argv[++i];
+        if (strcmp(arg, "--min") == 0)
+            options->min_count = (size_t)strtod(value, NULL);
+        else if (strcmp(arg, "--max") == 0)
+            options->max_count = (size_t)strtod(value, NULL);
+        else if (strcmp(arg, "--threads") == 0)
+            options->max_threads = (size_t)strtoul(value, NULL, 10);
+        else if (strcmp(arg, "--filter") == 0)
+            options->filter = value;
+        else if (strcmp(arg, "--sizes") == 0)
+        {
+            char *end = NULL;
+            options->elem_size_count = 0;
+            while (*value != '\0' && options->elem_size_count < 8)
+            {
+                size_t size = (size_t)strtoul(value, &end, 10);
+                options->elem_sizes[options->elem_size_count++] = size < 4 ? 4 : size;
+                value = (*end == ',') ? end + 1 : end;
+                if (end == value && *end != '\0')
+                    rbench_usage(argv[0]);
+            }
+        }
+        else
+            rbench_usage(argv[0]);
+    }
+
+    if (options->min_count == 0)
+        options->min_count = 1;
+    if (options->max_threads == 0)
+        options->max_threads = 1;
+}
+
+static unsigned char *rbench_make_elements(size_t count, size_t elem_size, bool sequential)
+{
+    unsigned char *elements = (unsigned char *)malloc(count * elem_size);
+    if (elements == NULL)
+        rbench_fail("out of memory while generating elements");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        unsigned char *element = elements + i * elem_size;
+        memset(element, (int)(i & 0xff), elem_size);
+        *(uint32_t *)element = (uint32_t)i;
+    }
+
+    if (!sequential)
+    {
+        uint64_t state = 0x9e3779b97f4a7c15u ^ count;
+        for (size_t i = count; i > 1; i--)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            size_t j = (size_t)(state % i);
+            uint32_t *a = (uint32_t *)(elements + (i - 1) * elem_size);
+            uint32_t *b = (uint32_t *)(elements + j * elem_size);
+            uint32_t tmp = *a;
+            *a = *b;
+            *b = tmp;
+        }
+    }
+
+    return (elements);
+}
+
+void rbench_run(const RBenchOptions *options, const char *name, RBenchCase fn,
+    size_t count, size_t elem_size, size_t threads, bool sequential)
+{
+    if (options->filter != NULL && strstr(name, options->filter) == NULL)
+        return;
+
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        rbench_status = 1;
+        return;
+    }
+
+    if (pid == 0)
+    {
+        RBenchParams params;
+        params.count = count;
+        params.elem_size = elem_size;
+        params.threads = threads;
+        params.elements = rbench_make_elements(count, elem_size, sequential);
+
+        rbench_state.name = name;
+        rbench_state.params = &params;
+        rbench_state.reported = false;
+        fn(&params);
+
+        free(params.elements);
+        fflush(stdout);
+        _exit(rbench_state.reported ? 0 : 1);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        printf("{\"bench\":\"%s\",\"count\":%zu,\"elem_size\":%zu,\"threads\":%zu,\"error\":\"case failed\"}\n",
+            name, count, elem_size, threads);
+        fflush(stdout);
+        rbench_status = 1;
+    }
+}
+
+int rbench_finish(void)
+{
+    return (rbench_status);
+}
+
+void rbench_begin(void)
+{
+    rbench_state.start_allocs = atomic_load(&rbench_allocs);
+    rbench_state.start_frees = atomic_load(&rbench_frees);
+    rbench_state.start_ns = rbench_now_ns();
+}
+
+void rbench_end(uint64_t ops)
+{
+    uint64_t elapsed = rbench_now_ns() - rbench_state.start_ns;
+    uint64_t allocs = atomic_load(&rbench_allocs) - rbench_state.start_allocs;
+    uint64_t frees = atomic_load(&rbench_frees) - rbench_state.start_frees;
+    const RBenchParams *params = rbench_state.params;
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+    if (ops == 0)
+        ops = 1;
+
+    printf("{\"bench\":\"%s\",\"count\":%zu,\"elem_size\":%zu,\"threads\":%zu,\"ops\":%llu,"
+        "\"ns_per_op\":%.3f,",
+        rbench_state.name, params->count, params->elem_size, params->threads,
+        (unsigned long long)ops, (double)elapsed / (double)ops);
+#ifdef RBENCH_WRAP_ALLOC
+    printf("\"allocs_per_op\":%.4f,\"frees_per_op\":%.4f,",
+        (double)allocs / (double)ops, (double)frees / (double)ops);
+#else
+    (void)allocs;
+    (void)frees;
+    printf("\"allocs_per_op\":null,\"frees_per_op\":null,");
+#endif
+    printf("\"peak_rss_kb\":%ld}\n", usage.ru_maxrss);
+    fflush(stdout);
+    rbench_state.reported = true;
+}
+
+void rbench_fail(const char *message)
+{
+    fprintf(stderr, "%s: %s\n", rbench_state.name != NULL ? rbench_state.name : "rbench", message);
+    fflush(stdout);
+    _exit(1);
+}
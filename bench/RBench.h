@@ -0,0 +1,118 @@
+/**
+ * @file RBench.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RBENCH_H__
+#define __RBENCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Input handed to every benchmark case.
+ *
+ * The elements buffer holds count elements of elem_size bytes each. The first
+ * four bytes of every element are a distinct uint32_t key; keys are a random
+ * permutation of [0, count) unless the case was registered as sequential.
+ */
+typedef struct RBenchParams
+{
+    size_t count;
+    size_t elem_size;
+    size_t threads;
+    unsigned char *elements;
+} RBenchParams;
+
+/**
+ * @brief Signature of a benchmark case.
+ *
+ * A case sets up whatever it needs, then brackets the measured loop with
+ * rbench_begin() and rbench_end().
+ */
+typedef void (*RBenchCase)(const RBenchParams *params);
+
+/**
+ * @brief Options parsed from the command line.
+ */
+typedef struct RBenchOptions
+{
+    size_t min_count;
+    size_t max_count;
+    size_t elem_sizes[8];
+    size_t elem_size_count;
+    size_t max_threads;
+    const char *filter;
+} RBenchOptions;
+
+/**
+ * @brief Parse the common command line options.
+ *
+ * Recognised options are --min N, --max N, --sizes A,B,C, --threads N and
+ * --filter SUBSTRING. Unknown options print usage and exit.
+ *
+ * @param options Receives the parsed options (defaults are filled in first).
+ * @param argc Argument count from main.
+ * @param argv Argument vector from main.
+ */
+void rbench_parse_options(RBenchOptions *options, int argc, char **argv);
+
+/**
+ * @brief Run one benchmark case in an isolated child process.
+ *
+ * The element buffer is generated inside the child, so the reported peak RSS
+ * belongs to this case alone. One JSON object is printed per run on stdout.
+ *
+ * @param options The parsed options (used for filtering).
+ * @param name The name reported in the output.
+ * @param fn The case to run.
+ * @param count Number of elements.
+ * @param elem_size Size of each element in bytes (at least 4).
+ * @param threads Number of threads the case should use.
+ * @param sequential true to give the elements ascending keys instead of a random permutation.
+ */
+void rbench_run(const RBenchOptions *options, const char *name, RBenchCase fn,
+    size_t count, size_t elem_size, size_t threads, bool sequential);
+
+/**
+ * @brief Get the process exit status after all cases ran.
+ *
+ * @return 0 if every case completed, 1 if any case failed or crashed.
+ */
+int rbench_finish(void);
+
+/**
+ * @brief Start the measured region of the current case.
+ */
+void rbench_begin(void);
+
+/**
+ * @brief End the measured region of the current case.
+ *
+ * @param ops The number of operations performed inside the region.
+ */
+void rbench_end(uint64_t ops);
+
+/**
+ * @brief Report a failed correctness check and terminate the case.
+ *
+ * @param message Description of what went wrong.
+ */
+void rbench_fail(const char *message);
+
+/**
+ * @brief Read the key stored in the first four bytes of an element.
+ */
+static inline uint32_t rbench_key(const void *element)
+{
+    return (*(const uint32_t *)element);
+}
+
+/**
+ * @brief Sink used by cases to keep the compiler from discarding results.
+ */
+extern volatile uint64_t rbench_sink;
+
+#endif //__RBENCH_H__
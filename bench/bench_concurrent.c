@@ -0,0 +1,577 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "RBench.h"
+#include "RRingQueue.h"
+#include "RSpscQueue.h"
+#include "RMpmcQueue.h"
+#include "RStack.h"
+#include "RLockFreeStack.h"
+#include "RBTree.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+/* Capacity of the queues handed between threads; small enough that producers regularly find them full. */
+#define RBENCH_QUEUE_CAPACITY 1024
+/* Number of elements moved per call by the batch cases. */
+#define RBENCH_BATCH 64
+
+#define RBENCH_ELEMENT(params, i) ((params)->elements + (size_t)(i) * (params)->elem_size)
+
+typedef struct RBenchSpsc
+{
+    const RBenchParams *params;
+    RSpscQueue *queue;
+} RBenchSpsc;
+
+static void *rbench_spsc_producer(void *arg)
+{
+    RBenchSpsc *ctx = (RBenchSpsc *)arg;
+    const RBenchParams *params = ctx->params;
+    for (size_t i = 0; i < params->count; i++)
+        while (!rspsc_try_enqueue(ctx->queue, RBENCH_ELEMENT(params, i)))
+            sched_yield();
+    return (NULL);
+}
+
+static void *rbench_spsc_producer_batch(void *arg)
+{
+    RBenchSpsc *ctx = (RBenchSpsc *)arg;
+    const RBenchParams *params = ctx->params;
+    size_t i = 0;
+    while (i < params->count)
+    {
+        size_t want = params->count - i < RBENCH_BATCH ? params->count - i : RBENCH_BATCH;
+        size_t sent = rspsc_try_enqueue_n(ctx->queue, RBENCH_ELEMENT(params, i), want);
+        if (sent == 0)
+            sched_yield();
+        i += sent;
+    }
+    return (NULL);
+}
+
+static void bench_rspsc_transfer(const RBenchParams *params)
+{
+    RBenchSpsc ctx = { params, rspsc_init(RBENCH_QUEUE_CAPACITY, params->elem_size) };
+    unsigned char *out = (unsigned char *)malloc(params->elem_size);
+    pthread_t producer;
+
+    rbench_begin();
+    pthread_create(&producer, NULL, rbench_spsc_producer, &ctx);
+    for (size_t i = 0; i < params->count; i++)
+    {
+        while (!rspsc_try_dequeue(ctx.queue, out))
+            sched_yield();
+    }
+    pthread_join(producer, NULL);
+    rbench_end(params->count);
+
+    if (rspsc_get_size(ctx.queue) != 0)
+        rbench_fail("queue not empty after transfer");
+    free(out);
+    rspsc_destroy(ctx.queue);
+}
+
+static void bench_rspsc_transfer_batch(const RBenchParams *params)
+{
+    RBenchSpsc ctx = { params, rspsc_init(RBENCH_QUEUE_CAPACITY, params->elem_size) };
+    unsigned char *out = (unsigned char *)malloc(RBENCH_BATCH * params->elem_size);
+    pthread_t producer;
+
+    rbench_begin();
+    pthread_create(&producer, NULL, rbench_spsc_producer_batch, &ctx);
+    size_t i = 0;
+    while (i < params->count)
+    {
+        size_t received = rspsc_try_dequeue_n(ctx.queue, out, RBENCH_BATCH);
+        if (received == 0)
+            sched_yield();
+        i += received;
+    }
+    pthread_join(producer, NULL);
+    rbench_end(params->count);
+
+    if (rspsc_get_size(ctx.queue) != 0)
+        rbench_fail("queue not empty after transfer");
+    free(out);
+    rspsc_destroy(ctx.queue);
+}
+
+/* Baseline: the same hand-off through an RRingQueue guarded by a mutex. */
+typedef struct RBenchLocked
+{
+    const RBenchParams *params;
+    RRingQueue *queue;
+    pthread_mutex_t lock;
+} RBenchLocked;
+
+static void *rbench_locked_producer(void *arg)
+{
+    RBenchLocked *ctx = (RBenchLocked *)arg;
+    const RBenchParams *params = ctx->params;
+    for (size_t i = 0; i < params->count; i++)
+    {
+        for (;;)
+        {
+            pthread_mutex_lock(&ctx->lock);
+            bool room = rrqueue_get_size(ctx->queue) < RBENCH_QUEUE_CAPACITY;
+            if (room)
+                rrqueue_enqueue(ctx->queue, RBENCH_ELEMENT(params, i));
+            pthread_mutex_unlock(&ctx->lock);
+            if (room)
+                break;
+            sched_yield();
+        }
+    }
+    return (NULL);
+}
+
+static void bench_rrqueue_mutex_transfer(const RBenchParams *params)
+{
+    RBenchLocked ctx;
+    unsigned char *out = (unsigned char *)malloc(params->elem_size);
+    pthread_t producer;
+
+    ctx.params = params;
+    ctx.queue = rrqueue_init(RBENCH_QUEUE_CAPACITY, params->elem_size);
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    rbench_begin();
+    pthread_create(&producer, NULL, rbench_locked_producer, &ctx);
+    for (size_t i = 0; i < params->count; i++)
+    {
+        for (;;)
+        {
+            pthread_mutex_lock(&ctx.lock);
+            bool found = rrqueue_dequeue(ctx.queue, out);
+            pthread_mutex_unlock(&ctx.lock);
+            if (found)
+                break;
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+    rbench_end(params->count);
+
+    pthread_mutex_destroy(&ctx.lock);
+    free(out);
+    rrqueue_destroy(ctx.queue);
+}
+
+/*
+ * Fan-in/fan-out: threads are split into producers and consumers. Producer p
+ * sends elements p, p + producers, p + 2 * producers, ...; consumers take
+ * elements until count have been received. The ordering and exactly-once
+ * checks live in tests/stress_concurrent.c and run under ctest.
+ */
+typedef struct RBenchFan
+{
+    const RBenchParams *params;
+    void *queue;
+    bool (*enqueue)(void *queue, const void *data);
+    bool (*dequeue)(void *queue, void *out);
+    size_t producers;
+    atomic_size_t received;
+} RBenchFan;
+
+typedef struct RBenchFanThread
+{
+    RBenchFan *fan;
+    size_t id;
+    pthread_t thread;
+} RBenchFanThread;
+
+static void *rbench_fan_producer(void *arg)
+{
+    RBenchFanThread *self = (RBenchFanThread *)arg;
+    RBenchFan *fan = self->fan;
+    const RBenchParams *params = fan->params;
+    for (size_t i = self->id; i < params->count; i += fan->producers)
+        while (!fan->enqueue(fan->queue, RBENCH_ELEMENT(params, i)))
+            sched_yield();
+    return (NULL);
+}
+
+static void *rbench_fan_consumer(void *arg)
+{
+    RBenchFanThread *self = (RBenchFanThread *)arg;
+    RBenchFan *fan = self->fan;
+    const RBenchParams *params = fan->params;
+    unsigned char *out = (unsigned char *)malloc(params->elem_size);
+
+    while (atomic_load_explicit(&fan->received, memory_order_relaxed) < params->count)
+    {
+        if (!fan->dequeue(fan->queue, out))
+        {
+            sched_yield();
+            continue;
+        }
+        atomic_fetch_add_explicit(&fan->received, 1, memory_order_relaxed);
+    }
+
+    free(out);
+    return (NULL);
+}
+
+static void rbench_fan_run(const RBenchParams *params, void *queue,
+    bool (*enqueue)(void *queue, const void *data), bool (*dequeue)(void *queue, void *out))
+{
+    size_t threads = params->threads < 2 ? 2 : params->threads;
+    RBenchFan fan;
+    RBenchFanThread *workers = (RBenchFanThread *)malloc(threads * sizeof(RBenchFanThread));
+
+    fan.params = params;
+    fan.queue = queue;
+    fan.enqueue = enqueue;
+    fan.dequeue = dequeue;
+    fan.producers = threads - threads / 2;
+    atomic_init(&fan.received, 0);
+
+    rbench_begin();
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers[t].fan = &fan;
+        workers[t].id = t < fan.producers ? t : t - fan.producers;
+        pthread_create(&workers[t].thread, NULL,
+            t < fan.producers ? rbench_fan_producer : rbench_fan_consumer, &workers[t]);
+    }
+    for (size_t t = 0; t < threads; t++)
+        pthread_join(workers[t].thread, NULL);
+    rbench_end(params->count);
+
+    free(workers);
+}
+
+static bool rbench_mpmc_enqueue(void *queue, const void *data)
+{
+    return (rmpmc_enqueue((RMpmcQueue *)queue, data));
+}
+
+static bool rbench_mpmc_dequeue(void *queue, void *out)
+{
+    return (rmpmc_dequeue((RMpmcQueue *)queue, out));
+}
+
+static void bench_rmpmc_fan(const RBenchParams *params)
+{
+    RMpmcQueue *queue = rmpmc_init(RBENCH_QUEUE_CAPACITY, params->elem_size);
+    rbench_fan_run(params, queue, rbench_mpmc_enqueue, rbench_mpmc_dequeue);
+    if (!rmpmc_is_empty(queue))
+        rbench_fail("queue not empty after transfer");
+    rmpmc_destroy(queue);
+}
+
+/* Baseline: one RRingQueue behind a global lock. */
+typedef struct RBenchLockedRing
+{
+    RRingQueue *queue;
+    pthread_mutex_t lock;
+} RBenchLockedRing;
+
+static bool rbench_locked_enqueue(void *queue, const void *data)
+{
+    RBenchLockedRing *ring = (RBenchLockedRing *)queue;
+    pthread_mutex_lock(&ring->lock);
+    bool room = rrqueue_get_size(ring->queue) < RBENCH_QUEUE_CAPACITY;
+    if (room)
+        rrqueue_enqueue(ring->queue, data);
+    pthread_mutex_unlock(&ring->lock);
+    return (room);
+}
+
+static bool rbench_locked_dequeue(void *queue, void *out)
+{
+    RBenchLockedRing *ring = (RBenchLockedRing *)queue;
+    pthread_mutex_lock(&ring->lock);
+    bool found = rrqueue_dequeue(ring->queue, out);
+    pthread_mutex_unlock(&ring->lock);
+    return (found);
+}
+
+static void bench_rrqueue_mutex_fan(const RBenchParams *params)
+{
+    RBenchLockedRing ring;
+    ring.queue = rrqueue_init(RBENCH_QUEUE_CAPACITY, params->elem_size);
+    pthread_mutex_init(&ring.lock, NULL);
+    rbench_fan_run(params, &ring, rbench_locked_enqueue, rbench_locked_dequeue);
+    pthread_mutex_destroy(&ring.lock);
+    rrqueue_destroy(ring.queue);
+}
+
+/*
+ * Contended stack: every thread pushes its own elements (i = id, id + threads,
+ * ...) one at a time and pops one element after each push, whichever thread's
+ * it is. The exactly-once check lives in tests/stress_concurrent.c and runs
+ * under ctest.
+ */
+typedef struct RBenchShared
+{
+    const RBenchParams *params;
+    void *stack;
+    void (*push)(void *stack, void *data);
+    bool (*pop)(void *stack, void **out);
+    size_t threads;
+} RBenchShared;
+
+typedef struct RBenchSharedThread
+{
+    RBenchShared *shared;
+    size_t id;
+    pthread_t thread;
+} RBenchSharedThread;
+
+static void *rbench_shared_worker(void *arg)
+{
+    RBenchSharedThread *self = (RBenchSharedThread *)arg;
+    RBenchShared *shared = self->shared;
+    const RBenchParams *params = shared->params;
+
+    for (size_t i = self->id; i < params->count; i += shared->threads)
+    {
+        void *data = NULL;
+        shared->push(shared->stack, RBENCH_ELEMENT(params, i));
+        while (!shared->pop(shared->stack, &data))
+            sched_yield();
+    }
+    return (NULL);
+}
+
+static void rbench_shared_run(const RBenchParams *params, void *stack,
+    void (*push)(void *stack, void *data), bool (*pop)(void *stack, void **out))
+{
+    RBenchShared shared;
+    RBenchSharedThread *workers = (RBenchSharedThread *)malloc(params->threads * sizeof(RBenchSharedThread));
+
+    shared.params = params;
+    shared.stack = stack;
+    shared.push = push;
+    shared.pop = pop;
+    shared.threads = params->threads;
+
+    rbench_begin();
+    for (size_t t = 0; t < params->threads; t++)
+    {
+        workers[t].shared = &shared;
+        workers[t].id = t;
+        pthread_create(&workers[t].thread, NULL, rbench_shared_worker, &workers[t]);
+    }
+    for (size_t t = 0; t < params->threads; t++)
+        pthread_join(workers[t].thread, NULL);
+    rbench_end(params->count * 2);
+
+    free(workers);
+}
+
+static void rbench_lfstack_push(void *stack, void *data)
+{
+    if (!rlfstack_push((RLockFreeStack *)stack, data))
+        rbench_fail("push failed");
+}
+
+static bool rbench_lfstack_pop(void *stack, void **out)
+{
+    return (rlfstack_try_pop((RLockFreeStack *)stack, out));
+}
+
+static void bench_rlfstack_push_pop(const RBenchParams *params)
+{
+    RLockFreeStack *stack = rlfstack_init();
+    rbench_shared_run(params, stack, rbench_lfstack_push, rbench_lfstack_pop);
+    if (!rlfstack_is_empty(stack) || rlfstack_get_size(stack) != 0)
+        rbench_fail("stack not empty after the run");
+    rlfstack_destroy(stack);
+}
+
+/* Baseline: RStack behind a mutex. */
+typedef struct RBenchLockedStack
+{
+    RStack *stack;
+    pthread_mutex_t lock;
+} RBenchLockedStack;
+
+static void rbench_locked_push(void *stack, void *data)
+{
+    RBenchLockedStack *locked = (RBenchLockedStack *)stack;
+    pthread_mutex_lock(&locked->lock);
+    rstack_push(locked->stack, data);
+    pthread_mutex_unlock(&locked->lock);
+}
+
+static bool rbench_locked_pop(void *stack, void **out)
+{
+    RBenchLockedStack *locked = (RBenchLockedStack *)stack;
+    pthread_mutex_lock(&locked->lock);
+    bool found = !rstack_is_empty(locked->stack);
+    if (found)
+        *out = rstack_pop(locked->stack);
+    pthread_mutex_unlock(&locked->lock);
+    return (found);
+}
+
+static void bench_rstack_mutex_push_pop(const RBenchParams *params)
+{
+    RBenchLockedStack locked;
+    locked.stack = rstack_init(params->elem_size);
+    pthread_mutex_init(&locked.lock, NULL);
+    rbench_shared_run(params, &locked, rbench_locked_push, rbench_locked_pop);
+    pthread_mutex_destroy(&locked.lock);
+    rstack_destroy(locked.stack);
+}
+
+/*
+ * Parallel tree scans: the tree is built untimed, then every element is folded
+ * once. The unordered case sums the keys; the ordered case also checks that
+ * partials arrive in ascending order, which a misordered combine would break.
+ */
+static bool rbench_tree_greater(const void *a, const void *b)
+{
+    return (rbench_key(a) > rbench_key(b));
+}
+
+static bool rbench_tree_less(const void *a, const void *b)
+{
+    return (rbench_key(a) < rbench_key(b));
+}
+
+static RBTree *rbench_tree_build(const RBenchParams *params)
+{
+    RBTree *tree = rbtree_init(params->elem_size, rbench_tree_greater, rbench_tree_less, NULL);
+    for (size_t i = 0; i < params->count; i++)
+        rbtree_insert(tree, RBENCH_ELEMENT(params, i));
+    return (tree);
+}
+
+static void rbench_sum_accumulate(void *partial, void *data, void *context)
+{
+    (void)context;
+    *(uint64_t *)partial += rbench_key(data);
+}
+
+static void rbench_sum_combine(void *result, const void *partial, void *context)
+{
+    (void)context;
+    *(uint64_t *)result += *(const uint64_t *)partial;
+}
+
+static void bench_rbtree_parallel_reduce(const RBenchParams *params)
+{
+    RBTree *tree = rbench_tree_build(params);
+    RBTreeReducer reducer = { sizeof(uint64_t), NULL, rbench_sum_accumulate, rbench_sum_combine, NULL };
+    uint64_t sum = 0;
+
+    rbench_begin();
+    if (!rbtree_parallel_reduce(tree, params->threads, &reducer, &sum))
+        rbench_fail("rbtree_parallel_reduce failed");
+    rbench_end(params->count);
+
+    if (sum != (uint64_t)params->count * (params->count - 1) / 2)
+        rbench_fail("parallel reduction lost or repeated elements");
+    rbtree_destroy(tree);
+}
+
+typedef struct RBenchRun
+{
+    uint64_t first;
+    uint64_t last;
+    uint64_t count;
+    uint64_t sorted;
+} RBenchRun;
+
+static void rbench_run_accumulate(void *partial, void *data, void *context)
+{
+    (void)context;
+    RBenchRun *run = (RBenchRun *)partial;
+    uint64_t key = rbench_key(data);
+    if (run->count == 0)
+        run->first = key;
+    else if (key <= run->last)
+        run->sorted = 0;
+    run->last = key;
+    run->count++;
+}
+
+static void rbench_run_init(void *partial, void *context)
+{
+    (void)context;
+    RBenchRun *run = (RBenchRun *)partial;
+    run->first = run->last = run->count = 0;
+    run->sorted = 1;
+}
+
+static void rbench_run_combine(void *result, const void *partial, void *context)
+{
+    (void)context;
+    RBenchRun *into = (RBenchRun *)result;
+    const RBenchRun *run = (const RBenchRun *)partial;
+    if (run->count == 0)
+        return;
+    if (into->count == 0)
+        into->first = run->first;
+    else if (run->first <= into->last)
+        into->sorted = 0;
+    into->last = run->last;
+    into->count += run->count;
+    into->sorted &= run->sorted;
+}
+
+static void bench_rbtree_parallel_reduce_ordered(const RBenchParams *params)
+{
+    RBTree *tree = rbench_tree_build(params);
+    RBTreeReducer reducer = { sizeof(RBenchRun), rbench_run_init, rbench_run_accumulate, rbench_run_combine, NULL };
+    RBenchRun run;
+
+    rbench_begin();
+    if (!rbtree_parallel_reduce_ordered(tree, params->threads, &reducer, &run))
+        rbench_fail("rbtree_parallel_reduce_ordered failed");
+    rbench_end(params->count);
+
+    if (run.count != params->count || !run.sorted)
+        rbench_fail("ordered reduction saw elements out of order");
+    rbtree_destroy(tree);
+}
+
+int main(int argc, char **argv)
+{
+    RBenchOptions options;
+    rbench_parse_options(&options, argc, argv);
+
+    for (size_t s = 0; s < options.elem_size_count; s++)
+    {
+        size_t elem_size = options.elem_sizes[s];
+        for (size_t n = options.min_count; n <= options.max_count; n *= 10)
+        {
+            rbench_run(&options, "rspsc_transfer", bench_rspsc_transfer, n, elem_size, 2, false);
+            rbench_run(&options, "rspsc_transfer_batch", bench_rspsc_transfer_batch, n, elem_size, 2, false);
+            rbench_run(&options, "rrqueue_mutex_transfer", bench_rrqueue_mutex_transfer, n, elem_size, 2, false);
+
+            /* Scaling: 2, 4, 8, ... threads up to --threads (always at least one producer and one consumer). */
+            for (size_t threads = 2;; threads *= 2)
+            {
+                if (threads > options.max_threads && threads > 2)
+                    threads = options.max_threads;
+                rbench_run(&options, "rmpmc_fan", bench_rmpmc_fan, n, elem_size, threads, false);
+                rbench_run(&options, "rrqueue_mutex_fan", bench_rrqueue_mutex_fan, n, elem_size, threads, false);
+                rbench_run(&options, "rlfstack_push_pop", bench_rlfstack_push_pop, n, elem_size, threads, false);
+                rbench_run(&options, "rstack_mutex_push_pop", bench_rstack_mutex_push_pop, n, elem_size, threads, false);
+                if (threads >= options.max_threads)
+                    break;
+            }
+
+            /* Tree scans start from one thread, the sequential baseline. */
+            for (size_t threads = 1;; threads *= 2)
+            {
+                if (threads > options.max_threads)
+                    threads = options.max_threads;
+                rbench_run(&options, "rbtree_parallel_reduce", bench_rbtree_parallel_reduce, n, elem_size, threads, false);
+                rbench_run(&options, "rbtree_parallel_reduce_ordered", bench_rbtree_parallel_reduce_ordered,
+                    n, elem_size, threads, false);
+                if (threads >= options.max_threads)
+                    break;
+            }
+        }
+    }
+
+    return (rbench_finish());
+}
@@ -0,0 +1,1167 @@
+#include "RBench.h"
+#include "RDynArray.h"
+#include "RDynArrayT.h"
+#include "RList.h"
+#include "RUList.h"
+#include "RDList.h"
+#include "RStack.h"
+#include "RArrayStack.h"
+#include "RQueue.h"
+#include "RRingQueue.h"
+#include "RBTree.h"
+#include "RBTreeT.h"
+#include "RBPTree.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Cases that are O(n^2) overall only run up to this many elements. */
+#define RBENCH_QUADRATIC_MAX 10000
+/* Number of searches performed by the linear lookup cases. */
+#define RBENCH_LOOKUPS 100
+
+/* Number of elements appended per call by the batch cases. */
+#define RBENCH_BATCH 4096
+
+/* Width, in keys, of each range visited by the range query cases. */
+#define RBENCH_WINDOW 64
+
+#define RBENCH_ELEMENT(params, i) ((params)->elements + (size_t)(i) * (params)->elem_size)
+
+static uint64_t rbench_traversal_sum;
+
+static int64_t rbench_list_compare(void *a, void *b)
+{
+    return ((int64_t)rbench_key(b) - (int64_t)rbench_key(a));
+}
+
+static bool rbench_greater(const void *a, const void *b)
+{
+    return (rbench_key(a) > rbench_key(b));
+}
+
+static bool rbench_less(const void *a, const void *b)
+{
+    return (rbench_key(a) < rbench_key(b));
+}
+
+static int64_t rbench_compare(const void *a, const void *b)
+{
+    return ((int64_t)rbench_key(a) - (int64_t)rbench_key(b));
+}
+
+static void rbench_accumulate(void *data)
+{
+    rbench_traversal_sum += rbench_key(data);
+}
+
+static void bench_rdarray_push_back(const RBenchParams *p)
+{
+    RDynArray *array = rdarray_init(16, p->elem_size);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rdarray_push_back(array, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rdarray_destroy(array);
+}
+
+static void bench_rdarray_push_back_n(const RBenchParams *p)
+{
+    RDynArray *array = rdarray_init(16, p->elem_size);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i += RBENCH_BATCH)
+    {
+        size_t batch = p->count - i < RBENCH_BATCH ? p->count - i : RBENCH_BATCH;
+        rdarray_push_back_n(array, RBENCH_ELEMENT(p, i), batch);
+    }
+    rbench_end(p->count);
+
+    if (rdarray_get_size(array) != p->count)
+        rbench_fail("batch append lost elements");
+    rdarray_destroy(array);
+}
+
+static void bench_rdarray_get(const RBenchParams *p)
+{
+    RDynArray *array = rdarray_init(16, p->elem_size);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rdarray_push_back(array, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        sum += rbench_key(rdarray_get(array, i));
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    rdarray_destroy(array);
+}
+
+typedef struct RBenchElem16 { uint32_t key; unsigned char payload[12]; } RBenchElem16;
+typedef struct RBenchElem64 { uint32_t key; unsigned char payload[60]; } RBenchElem64;
+
+RDARRAY_DEFINE(RBenchArray4, rbench_array4, uint32_t)
+RDARRAY_DEFINE(RBenchArray16, rbench_array16, RBenchElem16)
+RDARRAY_DEFINE(RBenchArray64, rbench_array64, RBenchElem64)
+
+/* Only the element sizes with a matching typed array are measured. */
+#define RBENCH_TYPED_CASES(bits)                                                        \
+    static void bench_rdarray_typed_push_back##bits(const RBenchParams *p)              \
+    {                                                                                   \
+        RBenchArray##bits *array = rbench_array##bits##_init(16);                       \
+        const RBenchElem##bits *elements = (const RBenchElem##bits *)p->elements;       \
+                                                                                        \
+        rbench_begin();                                                                 \
+        for (size_t i = 0; i < p->count; i++)                                           \
+            rbench_array##bits##_push_back(array, elements[i]);                         \
+        rbench_end(p->count);                                                           \
+                                                                                        \
+        rbench_array##bits##_destroy(array);                                            \
+    }                                                                                   \
+                                                                                        \
+    static void bench_rdarray_typed_get##bits(const RBenchParams *p)                    \
+    {                                                                                   \
+        RBenchArray##bits *array = rbench_array##bits##_init(16);                       \
+        const RBenchElem##bits *elements = (const RBenchElem##bits *)p->elements;       \
+        uint64_t sum = 0;                                                               \
+                                                                                        \
+        for (size_t i = 0; i < p->count; i++)                                           \
+            rbench_array##bits##_push_back(array, elements[i]);                         \
+                                                                                        \
+        rbench_begin();                                                                 \
+        for (size_t i = 0; i < p->count; i++)                                           \
+        {                                                                               \
+            RBenchElem##bits element = rbench_array##bits##_get(array, i);              \
+            sum += rbench_key(&element);                                                \
+        }                                                                               \
+        rbench_end(p->count);                                                           \
+                                                                                        \
+        rbench_sink = sum;                                                              \
+        rbench_array##bits##_destroy(array);                                            \
+    }
+
+typedef uint32_t RBenchElem4;
+RBENCH_TYPED_CASES(4)
+RBENCH_TYPED_CASES(16)
+RBENCH_TYPED_CASES(64)
+
+static void bench_rdarray_typed_push_back(const RBenchParams *p)
+{
+    if (p->elem_size == 4)
+        bench_rdarray_typed_push_back4(p);
+    else if (p->elem_size == 16)
+        bench_rdarray_typed_push_back16(p);
+    else
+        bench_rdarray_typed_push_back64(p);
+}
+
+static void bench_rdarray_typed_get(const RBenchParams *p)
+{
+    if (p->elem_size == 4)
+        bench_rdarray_typed_get4(p);
+    else if (p->elem_size == 16)
+        bench_rdarray_typed_get16(p);
+    else
+        bench_rdarray_typed_get64(p);
+}
+
+static void bench_rlist_insert_back(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rlist_destroy(list);
+}
+
+static void bench_rlist_insert_sorted(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_sorted(list, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    if (rlist_get_size(list) != p->count || !rlist_is_sorted(list))
+        rbench_fail("list is not sorted");
+    rlist_destroy(list);
+}
+
+static void bench_rlist_sort(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    rlist_sort(list);
+    rbench_end(p->count);
+
+    if (rlist_get_size(list) != p->count || !rlist_is_sorted(list))
+        rbench_fail("list is not sorted");
+    rlist_destroy(list);
+}
+
+static void bench_rlist_merge_sorted(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+    RList *other = rlist_init(p->elem_size, rbench_list_compare, NULL);
+
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(i % 2 == 0 ? list : other, RBENCH_ELEMENT(p, i));
+    rlist_sort(list);
+    rlist_sort(other);
+
+    rbench_begin();
+    rlist_merge_sorted(list, other);
+    rbench_end(p->count);
+
+    if (rlist_get_size(list) != p->count || !rlist_is_sorted(list))
+        rbench_fail("merged list is not sorted");
+    rlist_destroy(other);
+    rlist_destroy(list);
+}
+
+static void bench_rlist_get_element_scan(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        sum += rbench_key(rlist_get_element(list, i));
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    rlist_destroy(list);
+}
+
+static void bench_rlist_cursor_scan(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (RListCursor cursor = rlist_cursor_begin(list); rlist_cursor_valid(&cursor); rlist_cursor_next(&cursor))
+        sum += rbench_key(rlist_cursor_get(&cursor));
+    rbench_end(p->count);
+
+    if (sum != (uint64_t)p->count * (p->count - 1) / 2)
+        rbench_fail("cursor did not visit every element");
+    rlist_destroy(list);
+}
+
+static void bench_rlist_contains(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+    size_t lookups = p->count < RBENCH_LOOKUPS ? p->count : RBENCH_LOOKUPS;
+    uint64_t found = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < lookups; i++)
+        found += rlist_contains(list, RBENCH_ELEMENT(p, (i * 7919) % p->count));
+    rbench_end(lookups);
+
+    if (found != lookups)
+        rbench_fail("element not found");
+    rlist_destroy(list);
+}
+
+static void bench_rlist_inline_insert_back(const RBenchParams *p)
+{
+    RList *list = rlist_init_inline(p->elem_size, rbench_list_compare, NULL, NULL);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rlist_destroy(list);
+}
+
+static void bench_rlist_inline_contains(const RBenchParams *p)
+{
+    RList *list = rlist_init_inline(p->elem_size, rbench_list_compare, NULL, NULL);
+    size_t lookups = p->count < RBENCH_LOOKUPS ? p->count : RBENCH_LOOKUPS;
+    uint64_t found = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < lookups; i++)
+        found += rlist_contains(list, RBENCH_ELEMENT(p, (i * 7919) % p->count));
+    rbench_end(lookups);
+
+    if (found != lookups)
+        rbench_fail("element not found");
+    rlist_destroy(list);
+}
+
+static void bench_rlist_remove_back(const RBenchParams *p)
+{
+    RList *list = rlist_init(p->elem_size, rbench_list_compare, NULL);
+
+    for (size_t i = 0; i < p->count; i++)
+        rlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 1; i < p->count; i++)
+        rlist_remove_back(list);
+    rbench_end(p->count - 1);
+
+    rlist_destroy(list);
+}
+
+static void bench_rdlist_remove_back(const RBenchParams *p)
+{
+    RDList *list = rdlist_init(p->elem_size, rbench_list_compare, NULL);
+
+    for (size_t i = 0; i < p->count; i++)
+        rdlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rdlist_remove_back(list);
+    rbench_end(p->count);
+
+    rdlist_destroy(list);
+}
+
+static void bench_rdlist_remove_node(const RBenchParams *p)
+{
+    RDList *list = rdlist_init(p->elem_size, rbench_list_compare, NULL);
+    RDNode **handles = (RDNode **)malloc(p->count * sizeof(RDNode *));
+
+    for (size_t i = 0; i < p->count; i++)
+        handles[i] = rdlist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    /* The keys are a permutation of [0, count), so this removes in random order. */
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rdlist_remove_node(list, handles[rbench_key(RBENCH_ELEMENT(p, i))]);
+    rbench_end(p->count);
+
+    if (!rdlist_is_empty(list))
+        rbench_fail("list not empty after removing every handle");
+    free(handles);
+    rdlist_destroy(list);
+}
+
+static void bench_rulist_insert_back(const RBenchParams *p)
+{
+    RUList *list = rulist_init(p->elem_size, rbench_list_compare, NULL);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rulist_insert_back(list, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rulist_destroy(list);
+}
+
+static void bench_rulist_contains(const RBenchParams *p)
+{
+    RUList *list = rulist_init(p->elem_size, rbench_list_compare, NULL);
+    size_t lookups = p->count < RBENCH_LOOKUPS ? p->count : RBENCH_LOOKUPS;
+    uint64_t found = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rulist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < lookups; i++)
+        found += rulist_contains(list, RBENCH_ELEMENT(p, (i * 7919) % p->count));
+    rbench_end(lookups);
+
+    if (found != lookups)
+        rbench_fail("element not found");
+    rulist_destroy(list);
+}
+
+static void bench_rulist_get_element(const RBenchParams *p)
+{
+    RUList *list = rulist_init(p->elem_size, rbench_list_compare, NULL);
+    size_t lookups = p->count < RBENCH_LOOKUPS ? p->count : RBENCH_LOOKUPS;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rulist_insert_back(list, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < lookups; i++)
+        sum += rbench_key(rulist_get_element(list, (i * 7919) % p->count));
+    rbench_end(lookups);
+
+    rbench_sink = sum;
+    rulist_destroy(list);
+}
+
+static void bench_rstack_push(const RBenchParams *p)
+{
+    RStack *stack = rstack_init(p->elem_size);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rstack_push(stack, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rstack_destroy(stack);
+}
+
+static void bench_rstack_pop(const RBenchParams *p)
+{
+    RStack *stack = rstack_init(p->elem_size);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rstack_push(stack, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        sum += rbench_key(rstack_pop(stack));
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    rstack_destroy(stack);
+}
+
+static void bench_rstack_push_pop(const RBenchParams *p)
+{
+    RStack *stack = rstack_init(p->elem_size);
+    uint64_t sum = 0;
+
+    rstack_push(stack, RBENCH_ELEMENT(p, 0));
+    rstack_pop(stack);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        rstack_push(stack, RBENCH_ELEMENT(p, i));
+        sum += rbench_key(rstack_pop(stack));
+    }
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    rstack_destroy(stack);
+}
+
+static void bench_rastack_push(const RBenchParams *p)
+{
+    RArrayStack *stack = rastack_init(p->elem_size);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rastack_push(stack, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rastack_destroy(stack);
+}
+
+static void bench_rastack_pop(const RBenchParams *p)
+{
+    RArrayStack *stack = rastack_init(p->elem_size);
+    unsigned char *out = (unsigned char *)malloc(p->elem_size);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rastack_push(stack, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        rastack_pop(stack, out);
+        sum += rbench_key(out);
+    }
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    free(out);
+    rastack_destroy(stack);
+}
+
+static void bench_rastack_push_pop(const RBenchParams *p)
+{
+    RArrayStack *stack = rastack_init(p->elem_size);
+    unsigned char *out = (unsigned char *)malloc(p->elem_size);
+    uint64_t sum = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        rastack_push(stack, RBENCH_ELEMENT(p, i));
+        rastack_pop(stack, out);
+        sum += rbench_key(out);
+    }
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    free(out);
+    rastack_destroy(stack);
+}
+
+static void bench_rqueue_enqueue(const RBenchParams *p)
+{
+    RQueue *queue = rqueue_init(p->elem_size);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rqueue_destroy(queue);
+}
+
+static void bench_rqueue_dequeue(const RBenchParams *p)
+{
+    RQueue *queue = rqueue_init(p->elem_size);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        sum += rbench_key(rqueue_dequeue(queue));
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    rqueue_destroy(queue);
+}
+
+static void bench_rqueue_steady(const RBenchParams *p)
+{
+    RQueue *queue = rqueue_init(p->elem_size);
+    size_t depth = p->count < 64 ? p->count : 64;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < depth; i++)
+        rqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        rqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+        sum += rbench_key(rqueue_dequeue(queue));
+    }
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    rqueue_destroy(queue);
+}
+
+static void bench_rrqueue_enqueue(const RBenchParams *p)
+{
+    RRingQueue *queue = rrqueue_init(16, p->elem_size);
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        rrqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    rrqueue_destroy(queue);
+}
+
+static void bench_rrqueue_dequeue(const RBenchParams *p)
+{
+    RRingQueue *queue = rrqueue_init(16, p->elem_size);
+    unsigned char *out = (unsigned char *)malloc(p->elem_size);
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rrqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        rrqueue_dequeue(queue, out);
+        sum += rbench_key(out);
+    }
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    free(out);
+    rrqueue_destroy(queue);
+}
+
+static void bench_rrqueue_steady(const RBenchParams *p)
+{
+    RRingQueue *queue = rrqueue_init(16, p->elem_size);
+    unsigned char *out = (unsigned char *)malloc(p->elem_size);
+    size_t depth = p->count < 64 ? p->count : 64;
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < depth; i++)
+        rrqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        rrqueue_enqueue(queue, RBENCH_ELEMENT(p, i));
+        rrqueue_dequeue(queue, out);
+        sum += rbench_key(out);
+    }
+    rbench_end(p->count);
+
+    rbench_sink = sum;
+    free(out);
+    rrqueue_destroy(queue);
+}
+
+static RBTree *rbench_build_tree_ex(const RBenchParams *p, unsigned flags)
+{
+    RBTree *tree = rbtree_init_ex(p->elem_size, rbench_greater, rbench_less, NULL, flags, NULL);
+    for (size_t i = 0; i < p->count; i++)
+        rbtree_insert(tree, RBENCH_ELEMENT(p, i));
+    return (tree);
+}
+
+static RBTree *rbench_build_tree(const RBenchParams *p)
+{
+    return (rbench_build_tree_ex(p, 0));
+}
+
+static void bench_rbtree_insert_ex(const RBenchParams *p, unsigned flags)
+{
+    RBTree *tree = rbtree_init_ex(p->elem_size, rbench_greater, rbench_less, NULL, flags, NULL);
+
+    size_t inserted = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        inserted += rbtree_insert(tree, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    if (inserted != p->count)
+        rbench_fail("distinct keys were rejected");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_insert(const RBenchParams *p)
+{
+    bench_rbtree_insert_ex(p, 0);
+}
+
+static void bench_rbtree_insert_arena(const RBenchParams *p)
+{
+    bench_rbtree_insert_ex(p, RBTREE_ARENA);
+}
+
+static void bench_rbtree_insert_order_stats(const RBenchParams *p)
+{
+    bench_rbtree_insert_ex(p, RBTREE_ORDER_STATS);
+}
+
+static void bench_rbtree_destroy_ex(const RBenchParams *p, unsigned flags)
+{
+    RBTree *tree = rbench_build_tree_ex(p, flags);
+
+    rbench_begin();
+    rbtree_destroy(tree);
+    rbench_end(p->count);
+}
+
+static void bench_rbtree_destroy(const RBenchParams *p)
+{
+    bench_rbtree_destroy_ex(p, 0);
+}
+
+static void bench_rbtree_destroy_arena(const RBenchParams *p)
+{
+    bench_rbtree_destroy_ex(p, RBTREE_ARENA);
+}
+
+static void bench_rbtree_traversal_ex(const RBenchParams *p, unsigned flags,
+    void (*traverse)(RBTree *, void (*)(void *)))
+{
+    RBTree *tree = rbench_build_tree_ex(p, flags);
+
+    rbench_traversal_sum = 0;
+    rbench_begin();
+    traverse(tree, rbench_accumulate);
+    rbench_end(p->count);
+
+    if (rbench_traversal_sum != (uint64_t)p->count * (p->count - 1) / 2)
+        rbench_fail("traversal did not visit every element");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_traversal(const RBenchParams *p, void (*traverse)(RBTree *, void (*)(void *)))
+{
+    bench_rbtree_traversal_ex(p, 0, traverse);
+}
+
+static void bench_rbtree_inorder(const RBenchParams *p)
+{
+    bench_rbtree_traversal(p, rbtree_inorder);
+}
+
+static void bench_rbtree_preorder(const RBenchParams *p)
+{
+    bench_rbtree_traversal(p, rbtree_preorder);
+}
+
+static void bench_rbtree_postorder(const RBenchParams *p)
+{
+    bench_rbtree_traversal(p, rbtree_postorder);
+}
+
+static void bench_rbtree_inorder_arena(const RBenchParams *p)
+{
+    bench_rbtree_traversal_ex(p, RBTREE_ARENA, rbtree_inorder);
+}
+
+static void bench_rbtree_build_sorted(const RBenchParams *p)
+{
+    RBTree *tree = rbtree_init(p->elem_size, rbench_greater, rbench_less, NULL);
+
+    rbench_begin();
+    bool built = rbtree_build_sorted(tree, p->elements, p->count);
+    rbench_end(p->count);
+
+    if (!built || rbtree_get_size(tree) != p->count)
+        rbench_fail("build_sorted rejected sorted input");
+    uint32_t last = (uint32_t)(p->count - 1);
+    if (rbtree_find(tree, &last) == NULL)
+        rbench_fail("build_sorted lost an element");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_find(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree(p);
+    size_t found = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t key = (uint32_t)i;
+        found += rbtree_find(tree, &key) != NULL;
+    }
+    rbench_end(p->count);
+
+    if (found != p->count)
+        rbench_fail("find missed an element");
+    rbtree_destroy(tree);
+}
+
+/* Positions are queried in the shuffled order of the elements, so each lookup takes a different path. */
+static void bench_rbtree_select(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree_ex(p, RBTREE_ORDER_STATS);
+    size_t matched = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t k = rbench_key(RBENCH_ELEMENT(p, i));
+        matched += rbench_key(rbtree_select(tree, k)) == k;
+    }
+    rbench_end(p->count);
+
+    if (matched != p->count)
+        rbench_fail("select returned the wrong element");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_rank(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree_ex(p, RBTREE_ORDER_STATS);
+    size_t matched = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t key = rbench_key(RBENCH_ELEMENT(p, i));
+        matched += rbtree_rank(tree, &key) == key;
+    }
+    rbench_end(p->count);
+
+    if (matched != p->count)
+        rbench_fail("rank returned the wrong position");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_count_range(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree_ex(p, RBTREE_ORDER_STATS);
+    uint64_t counted = 0;
+    uint64_t expected = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t lo = rbench_key(RBENCH_ELEMENT(p, i));
+        uint32_t hi = lo + RBENCH_WINDOW;
+        counted += rbtree_count_range(tree, &lo, &hi);
+    }
+    rbench_end(p->count);
+
+    for (size_t i = 0; i < p->count; i++)
+        expected += p->count - i < RBENCH_WINDOW ? p->count - i : RBENCH_WINDOW;
+    if (counted != expected)
+        rbench_fail("count_range returned the wrong count");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_compare_insert(const RBenchParams *p)
+{
+    RBTree *tree = rbtree_init_compare(p->elem_size, rbench_compare, NULL);
+    size_t inserted = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        inserted += rbtree_insert(tree, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    if (inserted != p->count)
+        rbench_fail("distinct keys were rejected");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_compare_find(const RBenchParams *p)
+{
+    RBTree *tree = rbtree_init_compare(p->elem_size, rbench_compare, NULL);
+    size_t found = 0;
+
+    for (size_t i = 0; i < p->count; i++)
+        rbtree_insert(tree, RBENCH_ELEMENT(p, i));
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t key = (uint32_t)i;
+        found += rbtree_find(tree, &key) != NULL;
+    }
+    rbench_end(p->count);
+
+    if (found != p->count)
+        rbench_fail("find missed an element");
+    rbtree_destroy(tree);
+}
+
+/* The typed trees store whole elements by value and order them by their key. */
+#define RBENCH_TREE_COMPARE(a, b) ((rbench_key(a) > rbench_key(b)) - (rbench_key(a) < rbench_key(b)))
+
+RBTREE_DEFINE(RBenchTree4, rbench_tree4, RBenchElem4, RBENCH_TREE_COMPARE)
+RBTREE_DEFINE(RBenchTree16, rbench_tree16, RBenchElem16, RBENCH_TREE_COMPARE)
+RBTREE_DEFINE(RBenchTree64, rbench_tree64, RBenchElem64, RBENCH_TREE_COMPARE)
+
+#define RBENCH_TYPED_TREE_CASES(bits)                                                   \
+    static void bench_rbtree_typed_insert##bits(const RBenchParams *p)                  \
+    {                                                                                   \
+        RBenchTree##bits *tree = rbench_tree##bits##_init();                            \
+        const RBenchElem##bits *elements = (const RBenchElem##bits *)p->elements;       \
+        size_t inserted = 0;                                                            \
+                                                                                        \
+        rbench_begin();                                                                 \
+        for (size_t i = 0; i < p->count; i++)                                           \
+            inserted += rbench_tree##bits##_insert(tree, elements[i]);                  \
+        rbench_end(p->count);                                                           \
+                                                                                        \
+        if (inserted != p->count)                                                       \
+            rbench_fail("distinct keys were rejected");                                 \
+        rbench_tree##bits##_destroy(tree);                                              \
+    }                                                                                   \
+                                                                                        \
+    static void bench_rbtree_typed_find##bits(const RBenchParams *p)                    \
+    {                                                                                   \
+        RBenchTree##bits *tree = rbench_tree##bits##_init();                            \
+        const RBenchElem##bits *elements = (const RBenchElem##bits *)p->elements;       \
+        size_t found = 0;                                                               \
+        RBenchElem##bits key;                                                           \
+                                                                                        \
+        memset(&key, 0, sizeof(key));                                                   \
+        for (size_t i = 0; i < p->count; i++)                                           \
+            rbench_tree##bits##_insert(tree, elements[i]);                              \
+                                                                                        \
+        rbench_begin();                                                                 \
+        for (size_t i = 0; i < p->count; i++)                                           \
+        {                                                                               \
+            *(uint32_t *)&key = (uint32_t)i;                                            \
+            found += rbench_tree##bits##_find(tree, key) != NULL;                       \
+        }                                                                               \
+        rbench_end(p->count);                                                           \
+                                                                                        \
+        if (found != p->count)                                                          \
+            rbench_fail("find missed an element");                                      \
+        rbench_tree##bits##_destroy(tree);                                              \
+    }
+
+RBENCH_TYPED_TREE_CASES(4)
+RBENCH_TYPED_TREE_CASES(16)
+RBENCH_TYPED_TREE_CASES(64)
+
+static void bench_rbtree_typed_insert(const RBenchParams *p)
+{
+    if (p->elem_size == 4)
+        bench_rbtree_typed_insert4(p);
+    else if (p->elem_size == 16)
+        bench_rbtree_typed_insert16(p);
+    else
+        bench_rbtree_typed_insert64(p);
+}
+
+static void bench_rbtree_typed_find(const RBenchParams *p)
+{
+    if (p->elem_size == 4)
+        bench_rbtree_typed_find4(p);
+    else if (p->elem_size == 16)
+        bench_rbtree_typed_find16(p);
+    else
+        bench_rbtree_typed_find64(p);
+}
+
+static void bench_rbtree_lower_bound(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree(p);
+    uint64_t sum = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t key = (uint32_t)i;
+        sum += rbench_key(rbtree_lower_bound(tree, &key));
+    }
+    rbench_end(p->count);
+
+    if (sum != (uint64_t)p->count * (p->count - 1) / 2)
+        rbench_fail("lower_bound returned the wrong element");
+    rbtree_destroy(tree);
+}
+
+static bool rbench_count_visit(void *data, void *context)
+{
+    (void)data;
+    (*(size_t *)context)++;
+    return (false);
+}
+
+static void bench_rbtree_visit_range(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree(p);
+    size_t visited = 0;
+
+    rbench_begin();
+    for (size_t lo = 0; lo < p->count; lo += RBENCH_WINDOW)
+    {
+        uint32_t lo_key = (uint32_t)lo;
+        uint32_t hi_key = (uint32_t)(lo + RBENCH_WINDOW);
+        rbtree_visit_range(tree, &lo_key, &hi_key, rbench_count_visit, &visited);
+    }
+    rbench_end(p->count);
+
+    if (visited != p->count)
+        rbench_fail("range visit did not cover every element once");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_remove(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree(p);
+    size_t removed = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t key = (uint32_t)((i * 2654435761u) % p->count);
+        removed += rbtree_remove(tree, &key);
+    }
+    rbench_end(p->count);
+
+    if (removed != p->count || !rbtree_is_empty(tree))
+        rbench_fail("remove missed an element");
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_pop_min(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree(p);
+    uint32_t expected = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        if (rbench_key(rbtree_pop_min(tree)) != expected++)
+            rbench_fail("pop_min returned elements out of order");
+    rbench_end(p->count);
+
+    rbtree_destroy(tree);
+}
+
+static void bench_rbtree_iter(const RBenchParams *p)
+{
+    RBTree *tree = rbench_build_tree(p);
+    uint64_t sum = 0;
+
+    rbench_begin();
+    for (RBTreeIter iter = rbtree_iter_begin(tree); rbtree_iter_valid(&iter); rbtree_iter_next(&iter))
+        sum += rbench_key(rbtree_iter_get(&iter));
+    rbench_end(p->count);
+
+    if (sum != (uint64_t)p->count * (p->count - 1) / 2)
+        rbench_fail("iterator did not visit every element");
+    rbtree_destroy(tree);
+}
+
+static RBPTree *rbench_build_bptree(const RBenchParams *p)
+{
+    RBPTree *tree = rbptree_init(p->elem_size, rbench_greater, rbench_less);
+    for (size_t i = 0; i < p->count; i++)
+        rbptree_insert(tree, RBENCH_ELEMENT(p, i));
+    return (tree);
+}
+
+static void bench_rbptree_insert(const RBenchParams *p)
+{
+    RBPTree *tree = rbptree_init(p->elem_size, rbench_greater, rbench_less);
+    size_t inserted = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+        inserted += rbptree_insert(tree, RBENCH_ELEMENT(p, i));
+    rbench_end(p->count);
+
+    if (inserted != p->count)
+        rbench_fail("distinct keys were rejected");
+    rbptree_destroy(tree);
+}
+
+static void bench_rbptree_find(const RBenchParams *p)
+{
+    RBPTree *tree = rbench_build_bptree(p);
+    size_t found = 0;
+
+    rbench_begin();
+    for (size_t i = 0; i < p->count; i++)
+    {
+        uint32_t key = (uint32_t)i;
+        found += rbptree_find(tree, &key) != NULL;
+    }
+    rbench_end(p->count);
+
+    if (found != p->count)
+        rbench_fail("find missed an element");
+    rbptree_destroy(tree);
+}
+
+static void bench_rbptree_visit_range(const RBenchParams *p)
+{
+    RBPTree *tree = rbench_build_bptree(p);
+    size_t visited = 0;
+
+    rbench_begin();
+    for (size_t lo = 0; lo < p->count; lo += RBENCH_WINDOW)
+    {
+        uint32_t lo_key = (uint32_t)lo;
+        uint32_t hi_key = (uint32_t)(lo + RBENCH_WINDOW);
+        rbptree_visit_range(tree, &lo_key, &hi_key, rbench_count_visit, &visited);
+    }
+    rbench_end(p->count);
+
+    if (visited != p->count)
+        rbench_fail("range visit did not cover every element once");
+    rbptree_destroy(tree);
+}
+
+int main(int argc, char **argv)
+{
+    RBenchOptions options;
+    rbench_parse_options(&options, argc, argv);
+
+    for (size_t s = 0; s < options.elem_size_count; s++)
+    {
+        size_t elem_size = options.elem_sizes[s];
+        for (size_t n = options.min_count; n <= options.max_count; n *= 10)
+        {
+            rbench_run(&options, "rdarray_push_back", bench_rdarray_push_back, n, elem_size, 1, false);
+            rbench_run(&options, "rdarray_push_back_n", bench_rdarray_push_back_n, n, elem_size, 1, false);
+            rbench_run(&options, "rdarray_get", bench_rdarray_get, n, elem_size, 1, false);
+            if (elem_size == 4 || elem_size == 16 || elem_size == 64)
+            {
+                rbench_run(&options, "rdarray_typed_push_back", bench_rdarray_typed_push_back, n, elem_size, 1, false);
+                rbench_run(&options, "rdarray_typed_get", bench_rdarray_typed_get, n, elem_size, 1, false);
+            }
+            rbench_run(&options, "rlist_insert_back", bench_rlist_insert_back, n, elem_size, 1, false);
+            if (n <= RBENCH_QUADRATIC_MAX)
+                rbench_run(&options, "rlist_insert_sorted", bench_rlist_insert_sorted, n, elem_size, 1, false);
+            rbench_run(&options, "rlist_sort", bench_rlist_sort, n, elem_size, 1, false);
+            rbench_run(&options, "rlist_merge_sorted", bench_rlist_merge_sorted, n, elem_size, 1, false);
+            if (n <= RBENCH_QUADRATIC_MAX)
+                rbench_run(&options, "rlist_get_element_scan", bench_rlist_get_element_scan, n, elem_size, 1, false);
+            rbench_run(&options, "rlist_cursor_scan", bench_rlist_cursor_scan, n, elem_size, 1, false);
+            rbench_run(&options, "rlist_contains", bench_rlist_contains, n, elem_size, 1, false);
+            rbench_run(&options, "rlist_inline_insert_back", bench_rlist_inline_insert_back, n, elem_size, 1, false);
+            rbench_run(&options, "rlist_inline_contains", bench_rlist_inline_contains, n, elem_size, 1, false);
+            if (n <= RBENCH_QUADRATIC_MAX)
+                rbench_run(&options, "rlist_remove_back", bench_rlist_remove_back, n, elem_size, 1, false);
+            rbench_run(&options, "rdlist_remove_back", bench_rdlist_remove_back, n, elem_size, 1, false);
+            rbench_run(&options, "rdlist_remove_node", bench_rdlist_remove_node, n, elem_size, 1, false);
+            rbench_run(&options, "rulist_insert_back", bench_rulist_insert_back, n, elem_size, 1, false);
+            rbench_run(&options, "rulist_contains", bench_rulist_contains, n, elem_size, 1, false);
+            rbench_run(&options, "rulist_get_element", bench_rulist_get_element, n, elem_size, 1, false);
+            rbench_run(&options, "rstack_push", bench_rstack_push, n, elem_size, 1, false);
+            rbench_run(&options, "rstack_pop", bench_rstack_pop, n, elem_size, 1, false);
+            rbench_run(&options, "rstack_push_pop", bench_rstack_push_pop, n, elem_size, 1, false);
+            rbench_run(&options, "rastack_push", bench_rastack_push, n, elem_size, 1, false);
+            rbench_run(&options, "rastack_pop", bench_rastack_pop, n, elem_size, 1, false);
+            rbench_run(&options, "rastack_push_pop", bench_rastack_push_pop, n, elem_size, 1, false);
+            rbench_run(&options, "rqueue_enqueue", bench_rqueue_enqueue, n, elem_size, 1, false);
+            rbench_run(&options, "rqueue_dequeue", bench_rqueue_dequeue, n, elem_size, 1, false);
+            rbench_run(&options, "rqueue_steady", bench_rqueue_steady, n, elem_size, 1, false);
+            rbench_run(&options, "rrqueue_enqueue", bench_rrqueue_enqueue, n, elem_size, 1, false);
+            rbench_run(&options, "rrqueue_dequeue", bench_rrqueue_dequeue, n, elem_size, 1, false);
+            rbench_run(&options, "rrqueue_steady", bench_rrqueue_steady, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_insert", bench_rbtree_insert, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_insert_sequential", bench_rbtree_insert, n, elem_size, 1, true);
+            rbench_run(&options, "rbtree_insert_arena", bench_rbtree_insert_arena, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_insert_order_stats", bench_rbtree_insert_order_stats, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_compare_insert", bench_rbtree_compare_insert, n, elem_size, 1, false);
+            if (elem_size == 4 || elem_size == 16 || elem_size == 64)
+                rbench_run(&options, "rbtree_typed_insert", bench_rbtree_typed_insert, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_destroy", bench_rbtree_destroy, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_destroy_arena", bench_rbtree_destroy_arena, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_build_sorted", bench_rbtree_build_sorted, n, elem_size, 1, true);
+            rbench_run(&options, "rbtree_find", bench_rbtree_find, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_compare_find", bench_rbtree_compare_find, n, elem_size, 1, false);
+            if (elem_size == 4 || elem_size == 16 || elem_size == 64)
+                rbench_run(&options, "rbtree_typed_find", bench_rbtree_typed_find, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_lower_bound", bench_rbtree_lower_bound, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_visit_range", bench_rbtree_visit_range, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_select", bench_rbtree_select, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_rank", bench_rbtree_rank, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_count_range", bench_rbtree_count_range, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_remove", bench_rbtree_remove, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_pop_min", bench_rbtree_pop_min, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_inorder", bench_rbtree_inorder, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_inorder_arena", bench_rbtree_inorder_arena, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_preorder", bench_rbtree_preorder, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_postorder", bench_rbtree_postorder, n, elem_size, 1, false);
+            rbench_run(&options, "rbtree_iter", bench_rbtree_iter, n, elem_size, 1, false);
+            rbench_run(&options, "rbptree_insert", bench_rbptree_insert, n, elem_size, 1, false);
+            rbench_run(&options, "rbptree_insert_sequential", bench_rbptree_insert, n, elem_size, 1, true);
+            rbench_run(&options, "rbptree_find", bench_rbptree_find, n, elem_size, 1, false);
+            rbench_run(&options, "rbptree_visit_range", bench_rbptree_visit_range, n, elem_size, 1, false);
+        }
+    }
+
+    return (rbench_finish());
+}
@@ -0,0 +1,34 @@
+/**
+ * @file RCopy.h
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ */
+
+#ifndef __RCOPY_H__
+#define __RCOPY_H__
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Copy one element of a container.
+ *
+ * Internal helper for the containers that copy elements by value. Constant-size
+ * copies for common element sizes compile to plain moves instead of a memcpy call.
+ *
+ * @param dst The destination of the copy.
+ * @param src The element to copy.
+ * @param size The size of the element in bytes.
+ */
+static inline void rcopy_element(void *dst, const void *src, size_t size)
+{
+    switch (size)
+    {
+    case 4: memcpy(dst, src, 4); break;
+    case 8: memcpy(dst, src, 8); break;
+    case 16: memcpy(dst, src, 16); break;
+    default: memcpy(dst, src, size); break;
+    }
+}
+
+#endif //__RCOPY_H__
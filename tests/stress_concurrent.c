@@ -0,0 +1,417 @@
+/**
+ * @file stress_concurrent.c
+ * @author Radu-D. Chira (github.com/raduCh04)
+ * @date 2024-03-15
+ *
+ * Correctness checks for the concurrent containers. Each check hands a set of
+ * distinct elements between threads and fails if one is lost, duplicated,
+ * reordered or torn. Run one check per process: rstress_concurrent <check>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "RSpscQueue.h"
+#include "RMpmcQueue.h"
+#include "RLockFreeStack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+/* Elements moved per run; the queues are much smaller so they wrap and fill many times. */
+#define RSTRESS_COUNT 200000
+#define RSTRESS_QUEUE_CAPACITY 64
+/* Number of elements moved per call by the batch runs. */
+#define RSTRESS_BATCH 16
+/* Thread counts of the multi-threaded runs; each run splits them into producers and consumers. */
+static const size_t rstress_thread_counts[] = { 2, 3, 4, 8 };
+#define RSTRESS_THREAD_COUNT_COUNT (sizeof(rstress_thread_counts) / sizeof(rstress_thread_counts[0]))
+
+/* Covers the 4, 8 and 16 byte copy paths and the generic one. */
+static const size_t rstress_elem_sizes[] = { 4, 8, 16, 24 };
+#define RSTRESS_ELEM_SIZE_COUNT (sizeof(rstress_elem_sizes) / sizeof(rstress_elem_sizes[0]))
+
+typedef struct RStressElements
+{
+    size_t count;
+    size_t elem_size;
+    unsigned char *data;
+} RStressElements;
+
+#define RSTRESS_ELEMENT(elements, i) ((elements)->data + (size_t)(i) * (elements)->elem_size)
+
+static void rstress_fail(const char *check, const char *message)
+{
+    fprintf(stderr, "%s: %s\n", check, message);
+    exit(1);
+}
+
+/* Element i starts with the key i and is filled with a byte pattern that also depends on i. */
+static void rstress_elements_init(RStressElements *elements, size_t count, size_t elem_size)
+{
+    elements->count = count;
+    elements->elem_size = elem_size;
+    elements->data = (unsigned char *)malloc(count * elem_size);
+    if (elements->data == NULL)
+        rstress_fail("rstress", "out of memory while generating elements");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        unsigned char *element = RSTRESS_ELEMENT(elements, i);
+        for (size_t b = 0; b < elem_size; b++)
+            element[b] = (unsigned char)(i * 31 + b);
+        memcpy(element, &(uint32_t){ (uint32_t)i }, sizeof(uint32_t));
+    }
+}
+
+static void rstress_elements_destroy(RStressElements *elements)
+{
+    free(elements->data);
+}
+
+static uint32_t rstress_key(const void *element)
+{
+    uint32_t key;
+    memcpy(&key, element, sizeof(uint32_t));
+    return (key);
+}
+
+/* Fail unless received is a copy of element i. */
+static void rstress_check_element(const char *check, const RStressElements *elements, size_t i, const void *received)
+{
+    if (memcmp(received, RSTRESS_ELEMENT(elements, i), elements->elem_size) != 0)
+        rstress_fail(check, "element received out of order or corrupted");
+}
+
+/*
+ * SPSC ordering: one producer sends every element in order, one at a time or
+ * in batches, and the consumer checks that element i is the i-th one it
+ * receives.
+ */
+typedef struct RStressSpsc
+{
+    const RStressElements *elements;
+    RSpscQueue *queue;
+    bool batch;
+} RStressSpsc;
+
+static void *rstress_spsc_producer(void *arg)
+{
+    RStressSpsc *ctx = (RStressSpsc *)arg;
+    const RStressElements *elements = ctx->elements;
+    size_t i = 0;
+    while (i < elements->count)
+    {
+        size_t sent;
+        if (ctx->batch)
+        {
+            size_t want = elements->count - i < RSTRESS_BATCH ? elements->count - i : RSTRESS_BATCH;
+            sent = rspsc_try_enqueue_n(ctx->queue, RSTRESS_ELEMENT(elements, i), want);
+        }
+        else
+            sent = rspsc_try_enqueue(ctx->queue, RSTRESS_ELEMENT(elements, i)) ? 1 : 0;
+        if (sent == 0)
+            sched_yield();
+        i += sent;
+    }
+    return (NULL);
+}
+
+static void rstress_spsc_run(const RStressElements *elements, bool batch)
+{
+    RStressSpsc ctx = { elements, rspsc_init(RSTRESS_QUEUE_CAPACITY, elements->elem_size), batch };
+    unsigned char *out = (unsigned char *)malloc(RSTRESS_BATCH * elements->elem_size);
+    pthread_t producer;
+
+    if (ctx.queue == NULL || out == NULL)
+        rstress_fail("rspsc", "out of memory");
+    if (pthread_create(&producer, NULL, rstress_spsc_producer, &ctx) != 0)
+        rstress_fail("rspsc", "pthread_create failed");
+
+    size_t i = 0;
+    while (i < elements->count)
+    {
+        size_t received;
+        if (batch)
+            received = rspsc_try_dequeue_n(ctx.queue, out, RSTRESS_BATCH);
+        else
+            received = rspsc_try_dequeue(ctx.queue, out) ? 1 : 0;
+        if (received == 0)
+            sched_yield();
+        for (size_t j = 0; j < received; j++)
+            rstress_check_element("rspsc", elements, i + j, out + j * elements->elem_size);
+        i += received;
+    }
+    pthread_join(producer, NULL);
+
+    if (rspsc_get_size(ctx.queue) != 0)
+        rstress_fail("rspsc", "queue not empty after transfer");
+    free(out);
+    rspsc_destroy(ctx.queue);
+}
+
+static void rstress_spsc(const RStressElements *elements)
+{
+    rstress_spsc_run(elements, false);
+    rstress_spsc_run(elements, true);
+}
+
+/*
+ * MPMC fan-in/fan-out: producer p sends elements p, p + producers,
+ * p + 2 * producers, ...; consumers check that the elements of one producer
+ * reach them in the order that producer sent them and mark each element they
+ * receive. After the run every element must have been received exactly once.
+ */
+typedef struct RStressFan
+{
+    const RStressElements *elements;
+    RMpmcQueue *queue;
+    size_t producers;
+    atomic_uchar *seen;
+    atomic_size_t received;
+} RStressFan;
+
+typedef struct RStressFanThread
+{
+    RStressFan *fan;
+    size_t id;
+    pthread_t thread;
+} RStressFanThread;
+
+static void *rstress_fan_producer(void *arg)
+{
+    RStressFanThread *self = (RStressFanThread *)arg;
+    RStressFan *fan = self->fan;
+    const RStressElements *elements = fan->elements;
+    for (size_t i = self->id; i < elements->count; i += fan->producers)
+        while (!rmpmc_enqueue(fan->queue, RSTRESS_ELEMENT(elements, i)))
+            sched_yield();
+    return (NULL);
+}
+
+static void *rstress_fan_consumer(void *arg)
+{
+    RStressFanThread *self = (RStressFanThread *)arg;
+    RStressFan *fan = self->fan;
+    const RStressElements *elements = fan->elements;
+    unsigned char *out = (unsigned char *)malloc(elements->elem_size);
+    size_t *last = (size_t *)malloc(fan->producers * sizeof(size_t));
+
+    if (out == NULL || last == NULL)
+        rstress_fail("rmpmc", "out of memory");
+    for (size_t p = 0; p < fan->producers; p++)
+        last[p] = SIZE_MAX;
+    while (atomic_load_explicit(&fan->received, memory_order_relaxed) < elements->count)
+    {
+        if (!rmpmc_dequeue(fan->queue, out))
+        {
+            sched_yield();
+            continue;
+        }
+        size_t i = rstress_key(out);
+        if (i >= elements->count)
+            rstress_fail("rmpmc", "received an element that was never sent");
+        rstress_check_element("rmpmc", elements, i, out);
+        size_t producer = i % fan->producers;
+        if (last[producer] != SIZE_MAX && i <= last[producer])
+            rstress_fail("rmpmc", "elements of one producer received out of order");
+        last[producer] = i;
+        if (atomic_exchange_explicit(&fan->seen[i], 1, memory_order_relaxed) != 0)
+            rstress_fail("rmpmc", "element received twice");
+        atomic_fetch_add_explicit(&fan->received, 1, memory_order_relaxed);
+    }
+
+    free(last);
+    free(out);
+    return (NULL);
+}
+
+static void rstress_fan_run(const RStressElements *elements, size_t threads)
+{
+    RStressFan fan;
+    RStressFanThread *workers = (RStressFanThread *)malloc(threads * sizeof(RStressFanThread));
+
+    fan.elements = elements;
+    fan.queue = rmpmc_init(RSTRESS_QUEUE_CAPACITY, elements->elem_size);
+    fan.producers = threads - threads / 2;
+    fan.seen = (atomic_uchar *)calloc(elements->count, sizeof(atomic_uchar));
+    atomic_init(&fan.received, 0);
+    if (workers == NULL || fan.queue == NULL || fan.seen == NULL)
+        rstress_fail("rmpmc", "out of memory");
+
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers[t].fan = &fan;
+        workers[t].id = t < fan.producers ? t : t - fan.producers;
+        if (pthread_create(&workers[t].thread, NULL,
+                t < fan.producers ? rstress_fan_producer : rstress_fan_consumer, &workers[t]) != 0)
+            rstress_fail("rmpmc", "pthread_create failed");
+    }
+    for (size_t t = 0; t < threads; t++)
+        pthread_join(workers[t].thread, NULL);
+
+    for (size_t i = 0; i < elements->count; i++)
+        if (atomic_load(&fan.seen[i]) == 0)
+            rstress_fail("rmpmc", "element lost");
+    if (!rmpmc_is_empty(fan.queue) || rmpmc_get_size(fan.queue) != 0)
+        rstress_fail("rmpmc", "queue not empty after transfer");
+
+    rmpmc_destroy(fan.queue);
+    free(fan.seen);
+    free(workers);
+}
+
+static void rstress_mpmc(const RStressElements *elements)
+{
+    for (size_t t = 0; t < RSTRESS_THREAD_COUNT_COUNT; t++)
+        rstress_fan_run(elements, rstress_thread_counts[t]);
+}
+
+/*
+ * Contended lock-free stack: every thread pushes its own elements (i = id,
+ * id + threads, ...) and, after every few pushes, pops as many elements,
+ * whichever thread's they are. Nodes are recycled on every pop, so a stale
+ * compare-and-swap (ABA) shows up as a lost, duplicated or foreign pointer.
+ * Threads use different burst lengths; with equal ones the LIFO recycling
+ * tends to rebuild the very links a stale CAS expects, hiding the bug.
+ * Every element must be popped exactly once and the stack must end up empty.
+ */
+typedef struct RStressShared
+{
+    const RStressElements *elements;
+    RLockFreeStack *stack;
+    size_t threads;
+    size_t burst;
+    atomic_uchar *seen;
+} RStressShared;
+
+typedef struct RStressSharedThread
+{
+    RStressShared *shared;
+    size_t id;
+    pthread_t thread;
+} RStressSharedThread;
+
+static void rstress_lfstack_pop(RStressShared *shared)
+{
+    const RStressElements *elements = shared->elements;
+    void *data = NULL;
+    while (!rlfstack_try_pop(shared->stack, &data))
+        sched_yield();
+
+    size_t offset = (size_t)((unsigned char *)data - elements->data);
+    if ((unsigned char *)data < elements->data || offset % elements->elem_size != 0
+        || offset / elements->elem_size >= elements->count)
+        rstress_fail("rlfstack", "popped a pointer that was never pushed");
+    if (atomic_exchange_explicit(&shared->seen[offset / elements->elem_size], 1, memory_order_relaxed) != 0)
+        rstress_fail("rlfstack", "element popped twice");
+}
+
+static void *rstress_lfstack_worker(void *arg)
+{
+    RStressSharedThread *self = (RStressSharedThread *)arg;
+    RStressShared *shared = self->shared;
+    const RStressElements *elements = shared->elements;
+    size_t burst = shared->burst + self->id % 3;
+    size_t pending = 0;
+
+    for (size_t i = self->id; i < elements->count; i += shared->threads)
+    {
+        if (!rlfstack_push(shared->stack, RSTRESS_ELEMENT(elements, i)))
+            rstress_fail("rlfstack", "push failed");
+        if (++pending == burst)
+            for (; pending > 0; pending--)
+                rstress_lfstack_pop(shared);
+    }
+    for (; pending > 0; pending--)
+        rstress_lfstack_pop(shared);
+    return (NULL);
+}
+
+static void rstress_lfstack_run(const RStressElements *elements, size_t threads, size_t burst)
+{
+    RStressShared shared;
+    RStressSharedThread *workers = (RStressSharedThread *)malloc(threads * sizeof(RStressSharedThread));
+
+    shared.elements = elements;
+    shared.stack = rlfstack_init();
+    shared.threads = threads;
+    shared.burst = burst;
+    shared.seen = (atomic_uchar *)calloc(elements->count, sizeof(atomic_uchar));
+    if (workers == NULL || shared.stack == NULL || shared.seen == NULL)
+        rstress_fail("rlfstack", "out of memory");
+
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers[t].shared = &shared;
+        workers[t].id = t;
+        if (pthread_create(&workers[t].thread, NULL, rstress_lfstack_worker, &workers[t]) != 0)
+            rstress_fail("rlfstack", "pthread_create failed");
+    }
+    for (size_t t = 0; t < threads; t++)
+        pthread_join(workers[t].thread, NULL);
+
+    for (size_t i = 0; i < elements->count; i++)
+        if (atomic_load(&shared.seen[i]) == 0)
+            rstress_fail("rlfstack", "element lost");
+    if (!rlfstack_is_empty(shared.stack) || rlfstack_get_size(shared.stack) != 0)
+        rstress_fail("rlfstack", "stack not empty after the run");
+
+    rlfstack_destroy(shared.stack);
+    free(shared.seen);
+    free(workers);
+}
+
+static void rstress_lfstack(const RStressElements *elements)
+{
+    for (size_t t = 0; t < RSTRESS_THREAD_COUNT_COUNT; t++)
+    {
+        rstress_lfstack_run(elements, rstress_thread_counts[t], 1);
+        rstress_lfstack_run(elements, rstress_thread_counts[t], RSTRESS_BATCH);
+    }
+}
+
+typedef struct RStressCheck
+{
+    const char *name;
+    void (*run)(const RStressElements *elements);
+} RStressCheck;
+
+static const RStressCheck rstress_checks[] = {
+    { "rspsc", rstress_spsc },
+    { "rmpmc", rstress_mpmc },
+    { "rlfstack", rstress_lfstack },
+};
+#define RSTRESS_CHECK_COUNT (sizeof(rstress_checks) / sizeof(rstress_checks[0]))
+
+int main(int argc, char **argv)
+{
+    const RStressCheck *check = NULL;
+    for (size_t c = 0; argc == 2 && c < RSTRESS_CHECK_COUNT; c++)
+        if (strcmp(argv[1], rstress_checks[c].name) == 0)
+            check = &rstress_checks[c];
+
+    if (check == NULL)
+    {
+        fprintf(stderr, "usage: %s <check>\nchecks:", argv[0]);
+        for (size_t c = 0; c < RSTRESS_CHECK_COUNT; c++)
+            fprintf(stderr, " %s", rstress_checks[c].name);
+        fprintf(stderr, "\n");
+        return (2);
+    }
+
+    for (size_t s = 0; s < RSTRESS_ELEM_SIZE_COUNT; s++)
+    {
+        RStressElements elements;
+        rstress_elements_init(&elements, RSTRESS_COUNT, rstress_elem_sizes[s]);
+        check->run(&elements);
+        rstress_elements_destroy(&elements);
+    }
+    printf("%s: ok\n", check->name);
+    return (0);
+}